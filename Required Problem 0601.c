@@ -4,9 +4,15 @@
  *
  * This program combines all necessary functions from the multi-file project
  * into a single file. It features a memory quiz where users try to recall
- * the correct order of dance steps after a timed hint. The program includes
- * a fallback mechanism to use hardcoded data if the required input file is
- * not found, ensuring it can run in any environment.
+ * the correct order of dance steps after a timed hint. The dance file is
+ * memory-mapped and parsed in one pass: all names live in a single text pool,
+ * step names are interned to integer IDs, and every dance's steps are a slice
+ * of one shared ID array. Answers are scored on those IDs with partial credit
+ * for steps present, the longest run kept in order (LCS) and how few pairs are
+ * swapped (Kendall tau), and many submissions can be scored against one dance
+ * in a batch. The program includes a fallback mechanism to use hardcoded data
+ * if the required input file is not found, ensuring it can run in any
+ * environment.
  */
 
 #include <stdio.h>
@@ -14,6 +20,7 @@
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include <stdint.h>
 
 // For cross-platform sleep functionality
 #ifdef _WIN32
@@ -21,23 +28,74 @@
 #define sleep_seconds(s) Sleep((s) * 1000)
 #else
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #define sleep_seconds(s) sleep(s)
 #endif
 
 
 // --- Constants and Data Structures ---
-#define MAX_DANCES 10
-#define MAX_STEPS_PER_DANCE 10
+#define DANCE_FILENAME "dance_step.txt"
+#define STEP_NAME_SIZE 50
+// Score weights (out of 100): steps present, longest in-order run, pairwise order
+#define SCORE_WEIGHT_PRESENT 40
+#define SCORE_WEIGHT_LCS 30
+#define SCORE_WEIGHT_ORDER 30
 #define NUM_MEMBERS 4
+#define DANCE_INITIAL_CAPACITY 16
+#define TEXT_POOL_INITIAL_CAPACITY 4096
+#define STEP_TABLE_INITIAL_CAPACITY 64 // Hash slots; always a power of two
 
-// Structure to hold one complete dance
+// Structure to hold one complete dance. Names are offsets into g_text_pool; the
+// steps are g_step_ids[step_first .. step_first + step_count).
 typedef struct {
-    char korean_name[100];
-    char english_name[100];
-    char** steps; // Dynamic array of strings
+    uint32_t korean_name;
+    uint32_t english_name;
+    int step_first;
     int step_count;
 } Dance;
 
+// Every name in the dance database, NUL-terminated and addressed by offset
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} TextPool;
+
+// Interned step names: ID -> text offset, plus an open-addressing hash from text to ID
+typedef struct {
+    uint32_t* name_off;     // Indexed by step ID
+    int count;
+    int capacity;
+    int* slots;             // Step ID, or -1 for an empty slot
+    int slot_capacity;
+} StepTable;
+
+// A dance prepared for scoring many answers: its (step ID, position) pairs sorted
+// by ID then position, so each answer step finds its positions by binary search.
+// The scratch buffers are reused between answers and grow to the longest one.
+typedef struct {
+    const int* steps;
+    int step_count;
+    int distinct;           // No step repeats, so LCS reduces to an increasing run
+    int* sorted_ids;
+    int* sorted_pos;
+    int* used;              // Per ID group, how many positions this answer claimed
+    int* matched;           // Claimed positions in answer order
+    int* mapped;            // Every answer step's position (distinct dances only)
+    int* work;              // Merge-sort buffer, LIS tails or DP row
+    int scratch_capacity;
+} DanceScorer;
+
+// The outcome of scoring one answer
+typedef struct {
+    int score;              // 0-100
+    int matched;            // Answer steps paired with a distinct correct step
+    int lcs;                // Longest common subsequence with the correct order
+    long long inversions;   // Swapped pairs among the matched steps
+} StepScore;
+
 // Structure to hold a member's score
 typedef struct {
     char nickname[50];
@@ -48,6 +106,12 @@ typedef struct {
 // --- Global Data Storage ---
 Dance* g_dance_db = NULL;
 int g_dance_count = 0;
+int g_dance_capacity = 0;
+int* g_step_ids = NULL;     // Steps of every dance, back to back
+int g_step_id_count = 0;
+int g_step_id_capacity = 0;
+TextPool g_text_pool = {NULL, 0, 0};
+StepTable g_steps = {NULL, 0, 0, NULL, 0};
 MemberScore g_member_scores[NUM_MEMBERS];
 int g_scores_initialized = 0;
 
@@ -154,94 +218,240 @@ void show_main_menu() {
 // --- Feature Logic Functions ---
 
 /**
- * @brief Shuffles an array of strings using the Fisher-Yates algorithm.
+ * @brief Shuffles an array of step IDs using the Fisher-Yates algorithm.
  */
-void shuffle_string_array(char** array, int n) {
+void shuffle_step_ids(int* array, int n) {
     for (int i = n - 1; i > 0; i--) {
         int j = rand() % (i + 1);
-        char* temp = array[i];
+        int temp = array[i];
         array[i] = array[j];
         array[j] = temp;
     }
 }
 
+// --- Dance Database Storage ---
+static int poolAddText(const char* text, size_t len, uint32_t* off) {
+    if (g_text_pool.size + len + 1 > UINT32_MAX) return 0;
+    if (g_text_pool.size + len + 1 > g_text_pool.capacity) {
+        size_t new_capacity = g_text_pool.capacity ? g_text_pool.capacity : TEXT_POOL_INITIAL_CAPACITY;
+        while (new_capacity < g_text_pool.size + len + 1) new_capacity *= 2;
+        char* new_data = (char*)realloc(g_text_pool.data, new_capacity);
+        if (!new_data) return 0;
+        g_text_pool.data = new_data;
+        g_text_pool.capacity = new_capacity;
+    }
+    *off = (uint32_t)g_text_pool.size;
+    memcpy(g_text_pool.data + g_text_pool.size, text, len);
+    g_text_pool.data[g_text_pool.size + len] = '\0';
+    g_text_pool.size += len + 1;
+    return 1;
+}
+
+const char* poolText(uint32_t off) {
+    return g_text_pool.data + off;
+}
+
+const char* stepName(int id) {
+    return g_text_pool.data + g_steps.name_off[id];
+}
+
+const int* danceSteps(const Dance* p_dance) {
+    return g_step_ids + p_dance->step_first;
+}
+
+static uint32_t hashStepName(const char* text, size_t len) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int findStepSlot(const char* text, size_t len) {
+    int mask = g_steps.slot_capacity - 1;
+    int slot = (int)(hashStepName(text, len) & (uint32_t)mask);
+    while (g_steps.slots[slot] >= 0) {
+        const char* name = stepName(g_steps.slots[slot]);
+        if (strncmp(name, text, len) == 0 && name[len] == '\0') break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static int growStepSlots() {
+    int new_capacity = g_steps.slot_capacity ? g_steps.slot_capacity * 2 : STEP_TABLE_INITIAL_CAPACITY;
+    int* new_slots = (int*)malloc((size_t)new_capacity * sizeof(int));
+    if (!new_slots) return 0;
+    for (int i = 0; i < new_capacity; i++) new_slots[i] = -1;
+    free(g_steps.slots);
+    g_steps.slots = new_slots;
+    g_steps.slot_capacity = new_capacity;
+    for (int id = 0; id < g_steps.count; id++) {
+        const char* name = stepName(id);
+        g_steps.slots[findStepSlot(name, strlen(name))] = id;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the ID of a step name, or -1 if no dance uses it.
+ */
+int lookupStep(const char* name, size_t len) {
+    if (g_steps.slot_capacity == 0) return -1;
+    return g_steps.slots[findStepSlot(name, len)];
+}
+
+/**
+ * @brief Returns the ID of a step name, interning it the first time it is seen.
+ * @return The ID, or -1 on allocation failure.
+ */
+static int internStep(const char* name, size_t len) {
+    if (2 * (g_steps.count + 1) > g_steps.slot_capacity && !growStepSlots()) return -1;
+    int slot = findStepSlot(name, len);
+    if (g_steps.slots[slot] >= 0) return g_steps.slots[slot];
+    if (g_steps.count == g_steps.capacity) {
+        int new_capacity = g_steps.capacity ? g_steps.capacity * 2 : STEP_TABLE_INITIAL_CAPACITY;
+        uint32_t* new_off = (uint32_t*)realloc(g_steps.name_off, (size_t)new_capacity * sizeof(uint32_t));
+        if (!new_off) return -1;
+        g_steps.name_off = new_off;
+        g_steps.capacity = new_capacity;
+    }
+    if (!poolAddText(name, len, &g_steps.name_off[g_steps.count])) return -1;
+    g_steps.slots[slot] = g_steps.count;
+    return g_steps.count++;
+}
+
+/**
+ * @brief Appends a dance with no steps yet.
+ * @return Its index, or -1 on allocation failure.
+ */
+static int addDance(const char* korean, size_t korean_len, const char* english, size_t english_len) {
+    if (g_dance_count == g_dance_capacity) {
+        int new_capacity = g_dance_capacity ? g_dance_capacity * 2 : DANCE_INITIAL_CAPACITY;
+        Dance* new_db = (Dance*)realloc(g_dance_db, (size_t)new_capacity * sizeof(Dance));
+        if (!new_db) return -1;
+        g_dance_db = new_db;
+        g_dance_capacity = new_capacity;
+    }
+    Dance* p_dance = &g_dance_db[g_dance_count];
+    if (!poolAddText(korean, korean_len, &p_dance->korean_name)
+        || !poolAddText(english, english_len, &p_dance->english_name)) {
+        return -1;
+    }
+    p_dance->step_first = g_step_id_count;
+    p_dance->step_count = 0;
+    return g_dance_count++;
+}
+
+/**
+ * @brief Appends a step to the most recently added dance.
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int addDanceStep(const char* name, size_t len) {
+    int id = internStep(name, len);
+    if (id < 0) return 0;
+    if (g_step_id_count == g_step_id_capacity) {
+        int new_capacity = g_step_id_capacity ? g_step_id_capacity * 2 : STEP_TABLE_INITIAL_CAPACITY;
+        int* new_ids = (int*)realloc(g_step_ids, (size_t)new_capacity * sizeof(int));
+        if (!new_ids) return 0;
+        g_step_ids = new_ids;
+        g_step_id_capacity = new_capacity;
+    }
+    g_step_ids[g_step_id_count++] = id;
+    g_dance_db[g_dance_count - 1].step_count++;
+    return 1;
+}
+
+/**
+ * @brief Parses "korean;english;step,step,..." lines in one pass. Lines missing a
+ *        field are skipped and empty steps are ignored.
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int parseDanceData(const char* text, size_t size) {
+    const char* end = text + size;
+    while (text < end) {
+        const char* nl = (const char*)memchr(text, '\n', (size_t)(end - text));
+        const char* line_end = nl ? nl : end;
+        const char* cr = (const char*)memchr(text, '\r', (size_t)(line_end - text));
+        if (cr) line_end = cr;
+        const char* sep1 = (const char*)memchr(text, ';', (size_t)(line_end - text));
+        const char* sep2 = sep1 ? (const char*)memchr(sep1 + 1, ';', (size_t)(line_end - sep1 - 1)) : NULL;
+        if (sep2 && sep1 > text && sep2 > sep1 + 1 && line_end > sep2 + 1) {
+            if (addDance(text, (size_t)(sep1 - text), sep1 + 1, (size_t)(sep2 - sep1 - 1)) < 0) return 0;
+            const char* step = sep2 + 1;
+            while (step < line_end) {
+                const char* comma = (const char*)memchr(step, ',', (size_t)(line_end - step));
+                const char* step_end = comma ? comma : line_end;
+                if (step_end > step && !addDanceStep(step, (size_t)(step_end - step))) return 0;
+                step = comma ? comma + 1 : line_end;
+            }
+        }
+        text = nl ? nl + 1 : end;
+    }
+    return 1;
+}
+
+/**
+ * @brief Maps (or reads) the dance file and parses it.
+ * @return 1 if the file existed, 0 if it could not be opened.
+ */
+static int loadDanceFile() {
+    int ok = 1;
+#ifndef _WIN32
+    int fd = open(DANCE_FILENAME, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            ok = parseDanceData((const char*)map, (size_t)st.st_size);
+            munmap(map, (size_t)st.st_size);
+        } else {
+            perror("Failed to map '" DANCE_FILENAME "'");
+        }
+    }
+    close(fd);
+#else
+    FILE* file = fopen(DANCE_FILENAME, "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = size > 0 ? (char*)malloc((size_t)size) : NULL;
+    if (text && fread(text, 1, (size_t)size, file) == (size_t)size) ok = parseDanceData(text, (size_t)size);
+    free(text);
+    fclose(file);
+#endif
+    if (!ok) perror("Failed to store dance data");
+    return 1;
+}
+
 /**
  * @brief Loads dance data from a file, with a hardcoded fallback for online compilers.
  */
 void load_dance_data() {
     if (g_dance_db != NULL) return; // Already loaded
 
-    FILE* file = fopen("dance_step.txt", "r");
-    if (!file) {
+    if (!loadDanceFile()) {
         // --- Fallback for Online Compilers ---
-        printf("Notice: 'dance_step.txt' not found. Using hardcoded data as a fallback.\n");
-        
-        g_dance_db = (Dance*)malloc(6 * sizeof(Dance));
-        if(!g_dance_db) return;
-        g_dance_count = 6;
-        
-        // Data 1
-        strcpy(g_dance_db[0].korean_name, "웨이브"); strcpy(g_dance_db[0].english_name, "Wave");
-        g_dance_db[0].steps = (char**)malloc(3 * sizeof(char*));
-        g_dance_db[0].steps[0] = strdup("Arm Wave"); g_dance_db[0].steps[1] = strdup("Body Wave"); g_dance_db[0].steps[2] = strdup("Pop");
-        g_dance_db[0].step_count = 3;
-        // Data 2
-        strcpy(g_dance_db[1].korean_name, "기본 스텝"); strcpy(g_dance_db[1].english_name, "Basic Step");
-        g_dance_db[1].steps = (char**)malloc(4 * sizeof(char*));
-        g_dance_db[1].steps[0] = strdup("Two-Step"); g_dance_db[1].steps[1] = strdup("Grapevine"); g_dance_db[1].steps[2] = strdup("Box Step"); g_dance_db[1].steps[3] = strdup("Jazz Square");
-        g_dance_db[1].step_count = 4;
-        // ... (Additional hardcoded data) ...
-        strcpy(g_dance_db[2].korean_name, "슬라이드"); strcpy(g_dance_db[2].english_name, "Slide");
-        g_dance_db[2].steps = (char**)malloc(3 * sizeof(char*));
-        g_dance_db[2].steps[0] = strdup("Moonwalk"); g_dance_db[2].steps[1] = strdup("Side Glide"); g_dance_db[2].steps[2] = strdup("Circle Glide");
-        g_dance_db[2].step_count = 3;
-        strcpy(g_dance_db[3].korean_name, "팝핑"); strcpy(g_dance_db[3].english_name, "Popping");
-        g_dance_db[3].steps = (char**)malloc(4 * sizeof(char*));
-        g_dance_db[3].steps[0] = strdup("Hit"); g_dance_db[3].steps[1] = strdup("Dime Stop"); g_dance_db[3].steps[2] = strdup("Robot"); g_dance_db[3].steps[3] = strdup("Waving");
-        g_dance_db[3].step_count = 4;
-        strcpy(g_dance_db[4].korean_name, "락킹"); strcpy(g_dance_db[4].english_name, "Locking");
-        g_dance_db[4].steps = (char**)malloc(5 * sizeof(char*));
-        g_dance_db[4].steps[0] = strdup("Lock"); g_dance_db[4].steps[1] = strdup("Point"); g_dance_db[4].steps[2] = strdup("Pacing"); g_dance_db[4].steps[3] = strdup("Wrist Roll"); g_dance_db[4].steps[4] = strdup("Clap");
-        g_dance_db[4].step_count = 5;
-        strcpy(g_dance_db[5].korean_name, "턴"); strcpy(g_dance_db[5].english_name, "Turn");
-        g_dance_db[5].steps = (char**)malloc(3 * sizeof(char*));
-        g_dance_db[5].steps[0] = strdup("Pirouette"); g_dance_db[5].steps[1] = strdup("Chainé Turn"); g_dance_db[5].steps[2] = strdup("Fouetté Turn");
-        g_dance_db[5].step_count = 3;
-        return;
-    }
-    
-    // --- Original File Loading Logic ---
-    int lines = 0;
-    char buffer[1024];
-    while(fgets(buffer, sizeof(buffer), file)) lines++;
-    rewind(file);
-
-    g_dance_db = (Dance*)malloc(lines * sizeof(Dance));
-    if(!g_dance_db) { fclose(file); return; }
-
-    while(g_dance_count < lines && fgets(buffer, sizeof(buffer), file)) {
-        buffer[strcspn(buffer, "\r\n")] = 0;
-        Dance* p_dance = &g_dance_db[g_dance_count];
-        p_dance->step_count = 0;
-
-        char* kr_name = strtok(buffer, ";");
-        char* en_name = strtok(NULL, ";");
-        char* steps_str = strtok(NULL, "");
-        if(!kr_name || !en_name || !steps_str) continue;
-        
-        strcpy(p_dance->korean_name, kr_name);
-        strcpy(p_dance->english_name, en_name);
-        
-        p_dance->steps = (char**)malloc(MAX_STEPS_PER_DANCE * sizeof(char*));
-        char* step_token = strtok(steps_str, ",");
-        while(step_token != NULL && p_dance->step_count < MAX_STEPS_PER_DANCE) {
-            p_dance->steps[p_dance->step_count] = strdup(step_token);
-            p_dance->step_count++;
-            step_token = strtok(NULL, ",");
+        printf("Notice: '" DANCE_FILENAME "' not found. Using hardcoded data as a fallback.\n");
+        static const char* fallback[] = {
+            "웨이브;Wave;Arm Wave,Body Wave,Pop",
+            "기본 스텝;Basic Step;Two-Step,Grapevine,Box Step,Jazz Square",
+            "슬라이드;Slide;Moonwalk,Side Glide,Circle Glide",
+            "팝핑;Popping;Hit,Dime Stop,Robot,Waving",
+            "락킹;Locking;Lock,Point,Pacing,Wrist Roll,Clap",
+            "턴;Turn;Pirouette,Chainé Turn,Fouetté Turn"
+        };
+        for (size_t i = 0; i < sizeof(fallback) / sizeof(fallback[0]); i++) {
+            if (!parseDanceData(fallback[i], strlen(fallback[i]))) {
+                perror("Failed to store dance data");
+                return;
+            }
         }
-        g_dance_count++;
     }
-    fclose(file);
 }
 
 /**
@@ -249,55 +459,260 @@ void load_dance_data() {
  */
 void displayHint(const Dance* p_dance) {
     printf("\n--- Memorize This! Disappearing in 10 seconds... ---\n");
-    printf("Dance: %s (%s)\n", p_dance->korean_name, p_dance->english_name);
+    printf("Dance: %s (%s)\n", poolText(p_dance->korean_name), poolText(p_dance->english_name));
     printf("Correct Step Order:\n");
+    const int* steps = danceSteps(p_dance);
     for(int i=0; i<p_dance->step_count; i++) {
-        printf("  %d. %s\n", i+1, p_dance->steps[i]);
+        printf("  %d. %s\n", i+1, stepName(steps[i]));
     }
     sleep_seconds(10);
     clear_screen();
 }
 
+// --- Step Scoring ---
+static void sortStepPairs(int* ids, int* pos, int n) {
+    // Insertion sort for short dances; pairs are compared by (id, position)
+    for (int i = 1; i < n; i++) {
+        int id = ids[i], p = pos[i], j = i - 1;
+        while (j >= 0 && (ids[j] > id || (ids[j] == id && pos[j] > p))) {
+            ids[j + 1] = ids[j];
+            pos[j + 1] = pos[j];
+            j--;
+        }
+        ids[j + 1] = id;
+        pos[j + 1] = p;
+    }
+}
+
+static void mergeStepPairs(int* ids, int* pos, int* tmp_ids, int* tmp_pos, int n) {
+    if (n <= 16) {
+        sortStepPairs(ids, pos, n);
+        return;
+    }
+    int half = n / 2;
+    mergeStepPairs(ids, pos, tmp_ids, tmp_pos, half);
+    mergeStepPairs(ids + half, pos + half, tmp_ids, tmp_pos, n - half);
+    int i = 0, j = half, k = 0;
+    while (i < half || j < n) {
+        // Positions within a half are already in order, so ties on ID keep the left one first
+        if (j == n || (i < half && ids[i] <= ids[j])) { tmp_ids[k] = ids[i]; tmp_pos[k++] = pos[i++]; }
+        else { tmp_ids[k] = ids[j]; tmp_pos[k++] = pos[j++]; }
+    }
+    memcpy(ids, tmp_ids, (size_t)n * sizeof(int));
+    memcpy(pos, tmp_pos, (size_t)n * sizeof(int));
+}
+
+static void freeScratch(DanceScorer* scorer) {
+    free(scorer->matched);
+    free(scorer->mapped);
+    free(scorer->work);
+    scorer->matched = scorer->mapped = scorer->work = NULL;
+    scorer->scratch_capacity = 0;
+}
+
+void freeDanceScorer(DanceScorer* scorer) {
+    free(scorer->sorted_ids);
+    free(scorer->sorted_pos);
+    free(scorer->used);
+    freeScratch(scorer);
+    memset(scorer, 0, sizeof(*scorer));
+}
+
 /**
- * @brief Evaluates the user's answer against the correct steps and returns a score.
+ * @brief Indexes a dance's steps for scoring. Done once per dance, not per answer.
+ * @return 1 on success, 0 on allocation failure.
  */
-int evalScore(const Dance* p_dance, char user_steps[][50], int user_step_count) {
-    if(user_step_count != p_dance->step_count) return 0;
-
-    int perfect_match = 1;
-    for(int i=0; i<user_step_count; i++){
-        if(strcmp(p_dance->steps[i], user_steps[i]) != 0) {
-            perfect_match = 0;
-            break;
+int prepareDanceScorer(DanceScorer* scorer, const Dance* p_dance) {
+    memset(scorer, 0, sizeof(*scorer));
+    int n = p_dance->step_count;
+    scorer->steps = danceSteps(p_dance);
+    scorer->step_count = n;
+    size_t bytes = (size_t)(n > 0 ? n : 1) * sizeof(int);
+    scorer->sorted_ids = (int*)malloc(bytes);
+    scorer->sorted_pos = (int*)malloc(bytes);
+    scorer->used = (int*)malloc(bytes);
+    int* tmp_ids = (int*)malloc(bytes);
+    int* tmp_pos = (int*)malloc(bytes);
+    if (!scorer->sorted_ids || !scorer->sorted_pos || !scorer->used || !tmp_ids || !tmp_pos) {
+        free(tmp_ids);
+        free(tmp_pos);
+        freeDanceScorer(scorer);
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        scorer->sorted_ids[i] = scorer->steps[i];
+        scorer->sorted_pos[i] = i;
+    }
+    mergeStepPairs(scorer->sorted_ids, scorer->sorted_pos, tmp_ids, tmp_pos, n);
+    free(tmp_ids);
+    free(tmp_pos);
+    scorer->distinct = 1;
+    for (int i = 1; i < n; i++) {
+        if (scorer->sorted_ids[i] == scorer->sorted_ids[i - 1]) scorer->distinct = 0;
+    }
+    return 1;
+}
+
+static int reserveScratch(DanceScorer* scorer, int answer_count) {
+    int need = answer_count > scorer->step_count ? answer_count : scorer->step_count;
+    if (need + 1 <= scorer->scratch_capacity) return 1;
+    int capacity = scorer->scratch_capacity ? scorer->scratch_capacity : 16;
+    while (capacity < need + 1) capacity *= 2;
+    freeScratch(scorer);
+    scorer->matched = (int*)malloc((size_t)capacity * sizeof(int));
+    scorer->mapped = (int*)malloc((size_t)capacity * sizeof(int));
+    scorer->work = (int*)malloc((size_t)capacity * sizeof(int));
+    if (!scorer->matched || !scorer->mapped || !scorer->work) {
+        freeScratch(scorer);
+        return 0;
+    }
+    scorer->scratch_capacity = capacity;
+    return 1;
+}
+
+/**
+ * @brief Returns the first index of `id` in the sorted pairs, or -1.
+ */
+static int findStepGroup(const DanceScorer* scorer, int id) {
+    int lo = 0, hi = scorer->step_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (scorer->sorted_ids[mid] < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < scorer->step_count && scorer->sorted_ids[lo] == id ? lo : -1;
+}
+
+/**
+ * @brief Counts pairs i < j with a[i] > a[j] by merge sort, in O(n log n). Sorts `a`.
+ */
+static long long countInversions(int* a, int* tmp, int n) {
+    if (n < 2) return 0;
+    int half = n / 2;
+    long long inversions = countInversions(a, tmp, half) + countInversions(a + half, tmp, n - half);
+    int i = 0, j = half, k = 0;
+    while (i < half && j < n) {
+        if (a[i] <= a[j]) {
+            tmp[k++] = a[i++];
+        } else {
+            inversions += half - i; // a[j] is smaller than everything left in the left half
+            tmp[k++] = a[j++];
         }
     }
-    if(perfect_match) return 100;
-    
-    int correct_step_found[MAX_STEPS_PER_DANCE] = {0};
-    int all_words_match = 1;
-    for(int i=0; i<user_step_count; i++) {
-        int found_this_step = 0;
-        for(int j=0; j<p_dance->step_count; j++) {
-            if(!correct_step_found[j] && strcmp(user_steps[i], p_dance->steps[j]) == 0) {
-                correct_step_found[j] = 1;
-                found_this_step = 1;
-                break;
-            }
+    while (i < half) tmp[k++] = a[i++];
+    while (j < n) tmp[k++] = a[j++];
+    memcpy(a, tmp, (size_t)n * sizeof(int));
+    return inversions;
+}
+
+/**
+ * @brief Length of the longest strictly increasing subsequence, ignoring -1 entries.
+ */
+static int longestIncreasingRun(const int* a, int n, int* tails) {
+    int length = 0;
+    for (int i = 0; i < n; i++) {
+        if (a[i] < 0) continue;
+        int lo = 0, hi = length;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (tails[mid] < a[i]) lo = mid + 1;
+            else hi = mid;
         }
-        if(!found_this_step) {
-            all_words_match = 0;
-            break;
+        tails[lo] = a[i];
+        if (lo == length) length++;
+    }
+    return length;
+}
+
+/**
+ * @brief Classic O(n*m) LCS with one rolling row, for dances that repeat a step.
+ */
+static int longestCommonSubsequence(const int* a, int n, const int* b, int m, int* row) {
+    for (int j = 0; j <= m; j++) row[j] = 0;
+    for (int i = 1; i <= n; i++) {
+        int diag = 0;
+        for (int j = 1; j <= m; j++) {
+            int up = row[j];
+            row[j] = a[i - 1] == b[j - 1] ? diag + 1 : (row[j] > row[j - 1] ? row[j] : row[j - 1]);
+            diag = up;
         }
     }
-    if(all_words_match) return 50;
+    return row[m];
+}
 
-    for(int i=0; i<user_step_count; i++){
-        for(int j=0; j<p_dance->step_count; j++){
-            if(strcmp(user_steps[i], p_dance->steps[j]) == 0) return 20;
+/**
+ * @brief Scores an answer (step IDs, -1 for unknown names) against a prepared dance.
+ *
+ * Each answer step is paired with the earliest unclaimed occurrence of the same
+ * step in the dance. The score then combines:
+ *  - present: paired steps over the longer of the two sequences;
+ *  - LCS: longest run of steps kept in the correct relative order, over the same;
+ *  - order: 1 - inversions / pairs among the paired steps (Kendall tau), scaled
+ *    by the present share so a single lucky step cannot earn full order credit.
+ * A perfect answer scores 100; extra or missing steps lower every part.
+ */
+StepScore scoreStepIds(DanceScorer* scorer, const int* answer, int answer_count) {
+    StepScore result = {0, 0, 0, 0};
+    int n = scorer->step_count;
+    int longest = n > answer_count ? n : answer_count;
+    if (longest == 0 || !reserveScratch(scorer, answer_count)) return result;
+
+    memset(scorer->used, 0, (size_t)(n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < answer_count; i++) {
+        int group = answer[i] >= 0 ? findStepGroup(scorer, answer[i]) : -1;
+        scorer->mapped[i] = group >= 0 ? scorer->sorted_pos[group] : -1;
+        if (group < 0) continue;
+        int next = group + scorer->used[group];
+        if (next < n && scorer->sorted_ids[next] == answer[i]) {
+            scorer->used[group]++;
+            scorer->matched[result.matched++] = scorer->sorted_pos[next];
         }
     }
 
-    return 0;
+    // With no repeated steps every answer step has one position, and the LCS is
+    // the longest increasing run of those positions: O(m log m) instead of O(n*m).
+    if (scorer->distinct) result.lcs = longestIncreasingRun(scorer->mapped, answer_count, scorer->work);
+    else result.lcs = longestCommonSubsequence(scorer->steps, n, answer, answer_count, scorer->work);
+
+    int k = result.matched;
+    result.inversions = countInversions(scorer->matched, scorer->work, k);
+    double present = (double)k / longest;
+    double lcs = (double)result.lcs / longest;
+    double order = k < 2 ? 1.0 : 1.0 - (double)result.inversions / ((double)k * (k - 1) / 2);
+    double total = SCORE_WEIGHT_PRESENT * present + SCORE_WEIGHT_LCS * lcs + SCORE_WEIGHT_ORDER * order * present;
+    result.score = (int)(total + 0.5);
+    return result;
+}
+
+/**
+ * @brief Scores many answers against one dance, preparing the dance only once.
+ * @param answers answers[i] holds lengths[i] step IDs (-1 for unknown names).
+ * @return 1 on success, 0 on allocation failure (results are then incomplete).
+ */
+int scoreSubmissionBatch(const Dance* p_dance, const int* const* answers, const int* lengths, int count, StepScore* results) {
+    DanceScorer scorer;
+    if (!prepareDanceScorer(&scorer, p_dance)) return 0;
+    for (int i = 0; i < count; i++) {
+        if (!reserveScratch(&scorer, lengths[i])) { freeDanceScorer(&scorer); return 0; }
+        results[i] = scoreStepIds(&scorer, answers[i], lengths[i]);
+    }
+    freeDanceScorer(&scorer);
+    return 1;
+}
+
+/**
+ * @brief Evaluates the user's answer against the correct steps and returns a score.
+ */
+StepScore evalScore(const Dance* p_dance, char user_steps[][STEP_NAME_SIZE], int user_step_count) {
+    StepScore result = {0, 0, 0, 0};
+    int* answer = (int*)malloc((size_t)(user_step_count > 0 ? user_step_count : 1) * sizeof(int));
+    if (!answer) { perror("Failed to score answer"); return result; }
+    for (int i = 0; i < user_step_count; i++) answer[i] = lookupStep(user_steps[i], strlen(user_steps[i]));
+    if (!scoreSubmissionBatch(p_dance, (const int* const*)&answer, &user_step_count, 1, &result)) {
+        perror("Failed to score answer");
+    }
+    free(answer);
+    return result;
 }
 
 /**
@@ -341,34 +756,45 @@ void learnDanceStep() {
     
     // Present Puzzle
     printf("--- Let's Practice! ---\n");
-    printf("The dance is: %s (%s)\n", p_quiz_dance->korean_name, p_quiz_dance->english_name);
+    printf("The dance is: %s (%s)\n", poolText(p_quiz_dance->korean_name), poolText(p_quiz_dance->english_name));
     printf("Here are the steps in a random order:\n");
     
-    char** shuffled_steps = (char**)malloc(p_quiz_dance->step_count * sizeof(char*));
-    for(int i=0; i<p_quiz_dance->step_count; i++) shuffled_steps[i] = p_quiz_dance->steps[i];
-    shuffle_string_array(shuffled_steps, p_quiz_dance->step_count);
-    for(int i=0; i<p_quiz_dance->step_count; i++) printf("  - %s\n", shuffled_steps[i]);
+    const int* quiz_steps = danceSteps(p_quiz_dance);
+    int step_count = p_quiz_dance->step_count;
+    int* shuffled_steps = (int*)malloc((size_t)(step_count > 0 ? step_count : 1) * sizeof(int));
+    char (*user_steps)[STEP_NAME_SIZE] = malloc((size_t)(step_count > 0 ? step_count : 1) * STEP_NAME_SIZE);
+    if (!shuffled_steps || !user_steps) {
+        perror("Failed to set up the quiz");
+        free(shuffled_steps);
+        free(user_steps);
+        return;
+    }
+    memcpy(shuffled_steps, quiz_steps, (size_t)p_quiz_dance->step_count * sizeof(int));
+    shuffle_step_ids(shuffled_steps, p_quiz_dance->step_count);
+    for(int i=0; i<p_quiz_dance->step_count; i++) printf("  - %s\n", stepName(shuffled_steps[i]));
     free(shuffled_steps);
     
     // Get user input
     printf("\nPlease enter the %d steps in the correct order, one per line:\n", p_quiz_dance->step_count);
-    char user_steps[MAX_STEPS_PER_DANCE][50];
     for(int i=0; i<p_quiz_dance->step_count; i++){
         printf("Step %d: ", i+1);
-        fgets(user_steps[i], 50, stdin);
+        if (!fgets(user_steps[i], STEP_NAME_SIZE, stdin)) user_steps[i][0] = 0;
         user_steps[i][strcspn(user_steps[i], "\n")] = 0;
     }
     
     // Evaluate and display results
-    int score = evalScore(p_quiz_dance, user_steps, p_quiz_dance->step_count);
-    g_member_scores[member_idx].score = score;
+    StepScore result = evalScore(p_quiz_dance, user_steps, p_quiz_dance->step_count);
+    g_member_scores[member_idx].score = result.score;
     
     printf("\n--- Results for %s ---\n", g_milliways_nicknames[member_idx]);
     printf("Correct Order: ");
-    for(int i=0; i<p_quiz_dance->step_count; i++) printf("%s%s", p_quiz_dance->steps[i], (i==p_quiz_dance->step_count-1)?"":", ");
+    for(int i=0; i<p_quiz_dance->step_count; i++) printf("%s%s", stepName(quiz_steps[i]), (i==p_quiz_dance->step_count-1)?"":", ");
     printf("\nYour Input:    ");
     for(int i=0; i<p_quiz_dance->step_count; i++) printf("%s%s", user_steps[i], (i==p_quiz_dance->step_count-1)?"":", ");
-    printf("\n\nYour Score: %d / 100\n", score);
+    printf("\n\nYour Score: %d / 100\n", result.score);
+    printf("  Steps present: %d / %d, longest in order: %d, swapped pairs: %lld\n",
+           result.matched, p_quiz_dance->step_count, result.lcs, result.inversions);
+    free(user_steps);
     
     printf("\nPress Enter to return to menu...");
     getchar();
@@ -378,13 +804,15 @@ void learnDanceStep() {
  * @brief Frees all dynamically allocated memory at program exit.
  */
 void cleanup_dance_data() {
-    if(g_dance_db != NULL) {
-        for(int i=0; i < g_dance_count; i++) {
-            for(int j=0; j < g_dance_db[i].step_count; j++) {
-                free(g_dance_db[i].steps[j]);
-            }
-            free(g_dance_db[i].steps);
-        }
-        free(g_dance_db);
-    }
+    free(g_dance_db);
+    free(g_step_ids);
+    free(g_text_pool.data);
+    free(g_steps.name_off);
+    free(g_steps.slots);
+    g_dance_db = NULL;
+    g_step_ids = NULL;
+    g_dance_count = g_dance_capacity = 0;
+    g_step_id_count = g_step_id_capacity = 0;
+    memset(&g_text_pool, 0, sizeof(g_text_pool));
+    memset(&g_steps, 0, sizeof(g_steps));
 }
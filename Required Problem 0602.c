@@ -4,15 +4,23 @@
  *
  * This program combines all necessary functions into a single file. It features
  * a quiz on dance pattern knowledge and a bonus game to complete a choreography
- * chain. It includes a fallback mechanism to use hardcoded data if input files
- * are not found, ensuring it can run in any environment.
+ * chain. Pattern names are interned to small integer IDs (case-insensitively),
+ * and each song's choreography is a contiguous array of those IDs, so building a
+ * sequence is linear and comparing steps is an integer compare. Any number of
+ * songs can be loaded; a bigram/trigram transition model over all of them answers
+ * "what usually comes next" and "which songs contain this transition" without
+ * rescanning the catalogue. Quiz answers are checked with a bounded edit distance
+ * (Myers' bit-parallel algorithm), so small typos still count. It includes a
+ * fallback mechanism to use hardcoded data if input files are not found,
+ * ensuring it can run in any environment.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <ctype.h> // Included for tolower() used in my_stricmp()
+#include <ctype.h> // For tolower() and toupper()
+#include <stdint.h>
 
 // For cross-platform sleep functionality
 #ifdef _WIN32
@@ -26,28 +34,99 @@
 
 // --- Constants and Data Structures ---
 #define MAX_PATTERNS 10
-#define NUM_SONGS 4
+#define ANALYZED_FILENAME "analyz_dance-pattern.csv"
+#define SONG_INITIAL_CAPACITY 16
+#define NGRAM_TABLE_INITIAL_CAPACITY 256 // Hash slots; always a power of two
+#define SONG_LIST_PREVIEW 20             // Songs listed before "... and N more"
+#define FUZZY_WORD_BITS 64               // Longest guess handled bit-parallel
+#define FUZZY_MAX_TYPOS 2                // Typos allowed in long answers (one per 4 letters)
+#define NO_PATTERN (-1)
+#define TEXT_POOL_INITIAL_CAPACITY 4096
+#define NAME_TABLE_INITIAL_CAPACITY 64  // Hash slots; always a power of two
+#define SEQUENCE_INITIAL_CAPACITY 8
 
 // Structure for a single dance pattern from the database
 typedef struct {
     char name[100];
     char description[512];
+    int id;                 // Interned ID of `name`
 } DancePattern;
 
-// Node for the song's choreography sequence (Singly Linked List)
-typedef struct PatternNode {
-    char pattern_name[100]; // FIX: Corrected from 'name' to 'pattern_name'
-    struct PatternNode* next;
-} PatternNode;
+// A song's choreography sequence: pattern IDs in order, in one growable array
+typedef struct {
+    int* ids;
+    int length;
+    int capacity;
+} PatternSequence;
+
+// An analysed song. The title lives in g_text_pool.
+typedef struct {
+    uint32_t title_off;
+    PatternSequence sequence;
+} Song;
+
+// One n-gram (n = 1, 2 or 3) of consecutive pattern IDs seen in any song
+typedef struct {
+    int ids[3];
+    int n;
+    int count;              // Occurrences across all songs
+    int best_next;          // Most frequent pattern following this n-gram, or NO_PATTERN
+    int best_next_count;
+    int song_first;         // This n-gram's slice of g_transitions.songs
+    int song_count;         // Number of distinct songs containing it
+    int last_song;          // Build-time marker: last song counted or filled
+} NgramEntry;
+
+// The transition model: n-grams hashed by their IDs, plus, for each one, the
+// list of songs containing it stored contiguously in `songs`.
+typedef struct {
+    NgramEntry* entries;
+    int count;
+    int capacity;
+    int* slots;             // Entry index, or -1 for an empty slot
+    int slot_capacity;
+    int* songs;
+} TransitionModel;
+
+// A guess prepared for repeated edit-distance checks: lowercased once, with the
+// bit mask of its positions for every byte value (Myers' Peq table).
+typedef struct {
+    char key[100];
+    int length;
+    uint64_t peq[256];      // Valid when length <= FUZZY_WORD_BITS
+} FuzzyQuery;
+
+// Every interned name, NUL-terminated and addressed by offset
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} TextPool;
+
+// Interned pattern names. Names that differ only in case share an ID; the first
+// spelling seen is kept for display, next to a lowercased key used for lookups.
+typedef struct {
+    uint32_t* name_off;     // Indexed by ID
+    uint32_t* key_off;      // Indexed by ID
+    int count;
+    int capacity;
+    int* slots;             // ID, or NO_PATTERN for an empty slot
+    int slot_capacity;
+} PatternNameTable;
 
 
 // --- Global Data Storage ---
 DancePattern* g_pattern_db = NULL;
 int g_pattern_count = 0;
 
-// An array of Linked List heads, one for each song
-PatternNode* g_song_pattern_heads[NUM_SONGS] = {NULL};
-char g_song_titles[NUM_SONGS][100];
+// Analysed songs, in file order
+Song* g_songs = NULL;
+int g_song_count = 0;
+int g_song_capacity = 0;
+TransitionModel g_transitions = {NULL, 0, 0, NULL, 0, NULL};
+
+TextPool g_text_pool = {NULL, 0, 0};
+PatternNameTable g_pattern_names = {NULL, NULL, 0, 0, NULL, 0};
 
 
 // --- Forward Declarations for All Functions ---
@@ -57,6 +136,7 @@ void show_main_menu();
 void show_training_menu();
 void show_dance_menu();
 void learnDancePattern();
+void exploreTransitions();
 
 
 // --- Main Entry Point ---
@@ -96,6 +176,7 @@ void show_dance_menu() {
         printf("----------------------------------------\n");
         printf("   A. Learn Basic Dance Steps\n");
         printf("   B. Choreography Patterns\n");
+        printf("   C. Choreography Transition Explorer\n");
         printf("   0. Back\n");
         printf("----------------------------------------\n");
         printf("Select an option: ");
@@ -108,6 +189,8 @@ void show_dance_menu() {
              getchar();
         } else if (toupper(choice) == 'B') {
             learnDancePattern();
+        } else if (toupper(choice) == 'C') {
+            exploreTransitions();
         }
     } while (choice != '0');
 }
@@ -154,39 +237,136 @@ void show_main_menu() {
 
 // --- Feature Logic Functions ---
 
-// FIX: Custom case-insensitive string compare to replace non-standard stricmp()
-int my_stricmp(const char* s1, const char* s2) {
-    while (*s1 && (tolower((unsigned char)*s1) == tolower((unsigned char)*s2))) {
-        s1++;
-        s2++;
+// --- Pattern Name Interning ---
+static int poolAddText(const char* text, size_t len, int lowercase, uint32_t* off) {
+    if (g_text_pool.size + len + 1 > UINT32_MAX) return 0;
+    if (g_text_pool.size + len + 1 > g_text_pool.capacity) {
+        size_t new_capacity = g_text_pool.capacity ? g_text_pool.capacity : TEXT_POOL_INITIAL_CAPACITY;
+        while (new_capacity < g_text_pool.size + len + 1) new_capacity *= 2;
+        char* new_data = (char*)realloc(g_text_pool.data, new_capacity);
+        if (!new_data) return 0;
+        g_text_pool.data = new_data;
+        g_text_pool.capacity = new_capacity;
     }
-    return tolower((unsigned char)*s1) - tolower((unsigned char)*s2);
+    *off = (uint32_t)g_text_pool.size;
+    char* dest = g_text_pool.data + g_text_pool.size;
+    for (size_t i = 0; i < len; i++) dest[i] = lowercase ? (char)tolower((unsigned char)text[i]) : text[i];
+    dest[len] = '\0';
+    g_text_pool.size += len + 1;
+    return 1;
 }
 
-// --- Linked List Operations ---
-void add_pattern_to_list(PatternNode** p_head, const char* pattern_name) {
-    PatternNode* newNode = (PatternNode*)malloc(sizeof(PatternNode));
-    // FIX: Changed from newNode->name to newNode->pattern_name
-    strcpy(newNode->pattern_name, pattern_name);
-    newNode->next = NULL;
+const char* patternName(int id) {
+    return g_text_pool.data + g_pattern_names.name_off[id];
+}
 
-    if (*p_head == NULL) {
-        *p_head = newNode;
-    } else {
-        PatternNode* current = *p_head;
-        while(current->next != NULL) current = current->next;
-        current->next = newNode;
+const char* patternKey(int id) {
+    return g_text_pool.data + g_pattern_names.key_off[id];
+}
+
+static uint32_t hashPatternKey(const char* text, size_t len) {
+    uint32_t h = 2166136261u; // FNV-1a over the lowercased bytes
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)tolower((unsigned char)text[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Finds the slot holding `text` (compared case-insensitively), or the empty slot where it belongs.
+ */
+static int findPatternSlot(const char* text, size_t len) {
+    int mask = g_pattern_names.slot_capacity - 1;
+    int slot = (int)(hashPatternKey(text, len) & (uint32_t)mask);
+    while (g_pattern_names.slots[slot] != NO_PATTERN) {
+        const char* key = patternKey(g_pattern_names.slots[slot]);
+        size_t i = 0;
+        while (i < len && key[i] == (char)tolower((unsigned char)text[i])) i++;
+        if (i == len && key[len] == '\0') break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static int growPatternSlots() {
+    int new_capacity = g_pattern_names.slot_capacity ? g_pattern_names.slot_capacity * 2 : NAME_TABLE_INITIAL_CAPACITY;
+    int* new_slots = (int*)malloc((size_t)new_capacity * sizeof(int));
+    if (!new_slots) return 0;
+    for (int i = 0; i < new_capacity; i++) new_slots[i] = NO_PATTERN;
+    free(g_pattern_names.slots);
+    g_pattern_names.slots = new_slots;
+    g_pattern_names.slot_capacity = new_capacity;
+    for (int id = 0; id < g_pattern_names.count; id++) {
+        const char* key = patternKey(id);
+        g_pattern_names.slots[findPatternSlot(key, strlen(key))] = id;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the ID of a pattern name, or NO_PATTERN if it was never interned.
+ */
+int lookupPattern(const char* name, size_t len) {
+    if (g_pattern_names.slot_capacity == 0) return NO_PATTERN;
+    return g_pattern_names.slots[findPatternSlot(name, len)];
+}
+
+/**
+ * @brief Returns the ID of a pattern name, interning it the first time it is seen.
+ * @return The ID, or NO_PATTERN on allocation failure.
+ */
+int internPattern(const char* name, size_t len) {
+    if (2 * (g_pattern_names.count + 1) > g_pattern_names.slot_capacity && !growPatternSlots()) return NO_PATTERN;
+    int slot = findPatternSlot(name, len);
+    if (g_pattern_names.slots[slot] != NO_PATTERN) return g_pattern_names.slots[slot];
+    if (g_pattern_names.count == g_pattern_names.capacity) {
+        int new_capacity = g_pattern_names.capacity ? g_pattern_names.capacity * 2 : NAME_TABLE_INITIAL_CAPACITY;
+        uint32_t* new_name_off = (uint32_t*)realloc(g_pattern_names.name_off, (size_t)new_capacity * sizeof(uint32_t));
+        if (!new_name_off) return NO_PATTERN;
+        g_pattern_names.name_off = new_name_off;
+        uint32_t* new_key_off = (uint32_t*)realloc(g_pattern_names.key_off, (size_t)new_capacity * sizeof(uint32_t));
+        if (!new_key_off) return NO_PATTERN;
+        g_pattern_names.key_off = new_key_off;
+        g_pattern_names.capacity = new_capacity;
+    }
+    int id = g_pattern_names.count;
+    if (!poolAddText(name, len, 0, &g_pattern_names.name_off[id])
+        || !poolAddText(name, len, 1, &g_pattern_names.key_off[id])) {
+        return NO_PATTERN;
     }
+    g_pattern_names.slots[slot] = id;
+    g_pattern_names.count++;
+    return id;
 }
 
-void display_pattern_list(const PatternNode* head) {
-    if(!head) return;
-    const PatternNode* current = head;
-    while(current != NULL) {
-        // FIX: Changed from current->name to current->pattern_name
-        printf("%s", current->pattern_name);
-        if(current->next != NULL) printf(" -> ");
-        current = current->next;
+// --- Pattern Sequence Operations ---
+/**
+ * @brief Appends a pattern to the end of a sequence in amortized O(1).
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int appendPatternId(PatternSequence* seq, int id) {
+    if (seq->length == seq->capacity) {
+        int new_capacity = seq->capacity ? seq->capacity * 2 : SEQUENCE_INITIAL_CAPACITY;
+        int* new_ids = (int*)realloc(seq->ids, (size_t)new_capacity * sizeof(int));
+        if (!new_ids) return 0;
+        seq->ids = new_ids;
+        seq->capacity = new_capacity;
+    }
+    seq->ids[seq->length++] = id;
+    return 1;
+}
+
+int add_pattern_to_list(PatternSequence* seq, const char* pattern_name) {
+    int id = internPattern(pattern_name, strlen(pattern_name));
+    return id != NO_PATTERN && appendPatternId(seq, id);
+}
+
+void display_pattern_list(const PatternSequence* seq) {
+    if(seq->length == 0) return;
+    for (int i = 0; i < seq->length; i++) {
+        printf("%s", patternName(seq->ids[i]));
+        if(i + 1 < seq->length) printf(" -> ");
     }
     printf("\n");
 }
@@ -205,6 +385,7 @@ void load_dance_patterns() {
         strcpy(g_pattern_db[3].name, "Krumping"); strcpy(g_pattern_db[3].description, "A style of street dance characterized by free, expressive, and highly energetic moves.");
         strcpy(g_pattern_db[4].name, "Tutting"); strcpy(g_pattern_db[4].description, "A dance style that mimics the angular poses seen in ancient Egyptian art.");
         strcpy(g_pattern_db[5].name, "Voguing"); strcpy(g_pattern_db[5].description, "A modern house dance that evolved out of the Harlem ballroom scene in the 1980s.");
+        for (int i = 0; i < g_pattern_count; i++) g_pattern_db[i].id = internPattern(g_pattern_db[i].name, strlen(g_pattern_db[i].name));
         return;
     }
     
@@ -217,53 +398,353 @@ void load_dance_patterns() {
         if (name && desc) {
             strcpy(g_pattern_db[g_pattern_count].name, name);
             strcpy(g_pattern_db[g_pattern_count].description, desc);
+            g_pattern_db[g_pattern_count].id = internPattern(name, strlen(name));
             g_pattern_count++;
         }
     }
     fclose(file);
 }
 
+// --- Song Store ---
+const char* songTitle(const Song* song) {
+    return g_text_pool.data + song->title_off;
+}
+
+/**
+ * @brief Appends an empty song.
+ * @return Its index, or -1 on allocation failure.
+ */
+static int addSong(const char* title, size_t len) {
+    if (g_song_count == g_song_capacity) {
+        int new_capacity = g_song_capacity ? g_song_capacity * 2 : SONG_INITIAL_CAPACITY;
+        Song* new_songs = (Song*)realloc(g_songs, (size_t)new_capacity * sizeof(Song));
+        if (!new_songs) return -1;
+        g_songs = new_songs;
+        g_song_capacity = new_capacity;
+    }
+    Song* song = &g_songs[g_song_count];
+    memset(song, 0, sizeof(*song));
+    if (!poolAddText(title, len, 0, &song->title_off)) return -1;
+    return g_song_count++;
+}
+
+/**
+ * @brief Parses "title,pattern,pattern,..." lines. Empty fields are skipped, so
+ *        the first non-empty field is the title.
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int parseAnalyzedPatterns(const char* text, size_t size) {
+    const char* end = text + size;
+    while (text < end) {
+        const char* nl = (const char*)memchr(text, '\n', (size_t)(end - text));
+        const char* line_end = nl ? nl : end;
+        const char* cr = (const char*)memchr(text, '\r', (size_t)(line_end - text));
+        if (cr) line_end = cr;
+        int song = -1;
+        const char* field = text;
+        while (field < line_end) {
+            const char* comma = (const char*)memchr(field, ',', (size_t)(line_end - field));
+            const char* field_end = comma ? comma : line_end;
+            if (field_end > field) {
+                if (song < 0) {
+                    if ((song = addSong(field, (size_t)(field_end - field))) < 0) return 0;
+                } else {
+                    int id = internPattern(field, (size_t)(field_end - field));
+                    if (id == NO_PATTERN || !appendPatternId(&g_songs[song].sequence, id)) return 0;
+                }
+            }
+            field = comma ? comma + 1 : line_end;
+        }
+        text = nl ? nl + 1 : end;
+    }
+    return 1;
+}
+
 void load_analyzed_patterns() {
-    if (g_song_pattern_heads[0] != NULL) return;
-    FILE* file = fopen("analyz_dance-pattern.csv", "r");
+    if (g_song_count > 0) return;
+    FILE* file = fopen(ANALYZED_FILENAME, "rb");
     if(!file) {
-        printf("Notice: 'analyz_dance-pattern.csv' not found. Using hardcoded fallback data.\n");
-        strcpy(g_song_titles[0], "DDU-DU DDU-DU");
-        add_pattern_to_list(&g_song_pattern_heads[0], "Popping");
-        add_pattern_to_list(&g_song_pattern_heads[0], "Voguing");
-        add_pattern_to_list(&g_song_pattern_heads[0], "Waacking");
-
-        strcpy(g_song_titles[1], "Blood Sweat & Tears");
-        add_pattern_to_list(&g_song_pattern_heads[1], "Tutting");
-        add_pattern_to_list(&g_song_pattern_heads[1], "Voguing");
-        add_pattern_to_list(&g_song_pattern_heads[1], "Locking");
-        strcpy(g_song_titles[2], "Sherlock");
-        add_pattern_to_list(&g_song_pattern_heads[2], "Popping");
-        add_pattern_to_list(&g_song_pattern_heads[2], "Locking");
-        add_pattern_to_list(&g_song_pattern_heads[2], "Tutting");
-        strcpy(g_song_titles[3], "BOOMBAYAH");
-        add_pattern_to_list(&g_song_pattern_heads[3], "Waacking");
-        add_pattern_to_list(&g_song_pattern_heads[3], "Popping");
-        add_pattern_to_list(&g_song_pattern_heads[3], "Krumping");
+        printf("Notice: '" ANALYZED_FILENAME "' not found. Using hardcoded fallback data.\n");
+        static const char* fallback[][4] = {
+            {"DDU-DU DDU-DU", "Popping", "Voguing", "Waacking"},
+            {"Blood Sweat & Tears", "Tutting", "Voguing", "Locking"},
+            {"Sherlock", "Popping", "Locking", "Tutting"},
+            {"BOOMBAYAH", "Waacking", "Popping", "Krumping"}
+        };
+        for (size_t i = 0; i < sizeof(fallback) / sizeof(fallback[0]); i++) {
+            int song = addSong(fallback[i][0], strlen(fallback[i][0]));
+            if (song < 0) break;
+            for (int k = 1; k < 4; k++) add_pattern_to_list(&g_songs[song].sequence, fallback[i][k]);
+        }
         return;
     }
 
-    char line[1024];
-    int song_idx = 0;
-    while(song_idx < NUM_SONGS && fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\r\n")] = 0;
-        char* token = strtok(line, ",");
-        if(token) {
-            strcpy(g_song_titles[song_idx], token);
-            token = strtok(NULL, ",");
+    // One read of the whole file, then an in-memory parse
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = size > 0 ? (char*)malloc((size_t)size) : NULL;
+    if (text && fread(text, 1, (size_t)size, file) == (size_t)size) {
+        if (!parseAnalyzedPatterns(text, (size_t)size)) perror("Failed to store analysed patterns");
+    } else if (size > 0) {
+        perror("Failed to read '" ANALYZED_FILENAME "'");
+    }
+    free(text);
+    fclose(file);
+}
+
+// --- Transition Model ---
+static uint32_t hashNgram(const int* ids, int n) {
+    uint32_t h = 2166136261u ^ (uint32_t)n; // FNV-1a over the IDs
+    for (int i = 0; i < n; i++) {
+        h ^= (uint32_t)ids[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int findNgramSlot(const TransitionModel* model, const int* ids, int n) {
+    int mask = model->slot_capacity - 1;
+    int slot = (int)(hashNgram(ids, n) & (uint32_t)mask);
+    while (model->slots[slot] >= 0) {
+        const NgramEntry* e = &model->entries[model->slots[slot]];
+        if (e->n == n && memcmp(e->ids, ids, (size_t)n * sizeof(int)) == 0) break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Returns the entry for an n-gram, or NULL if no song contains it.
+ */
+const NgramEntry* findNgram(const int* ids, int n) {
+    if (g_transitions.slot_capacity == 0) return NULL;
+    int index = g_transitions.slots[findNgramSlot(&g_transitions, ids, n)];
+    return index >= 0 ? &g_transitions.entries[index] : NULL;
+}
+
+static int growNgramSlots(TransitionModel* model) {
+    int new_capacity = model->slot_capacity ? model->slot_capacity * 2 : NGRAM_TABLE_INITIAL_CAPACITY;
+    int* new_slots = (int*)malloc((size_t)new_capacity * sizeof(int));
+    if (!new_slots) return 0;
+    for (int i = 0; i < new_capacity; i++) new_slots[i] = -1;
+    free(model->slots);
+    model->slots = new_slots;
+    model->slot_capacity = new_capacity;
+    for (int i = 0; i < model->count; i++) {
+        model->slots[findNgramSlot(model, model->entries[i].ids, model->entries[i].n)] = i;
+    }
+    return 1;
+}
+
+/**
+ * @brief Counts one occurrence of an n-gram in `song`.
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int countNgram(TransitionModel* model, const int* ids, int n, int song) {
+    if (2 * (model->count + 1) > model->slot_capacity && !growNgramSlots(model)) return 0;
+    int slot = findNgramSlot(model, ids, n);
+    if (model->slots[slot] < 0) {
+        if (model->count == model->capacity) {
+            int new_capacity = model->capacity ? model->capacity * 2 : NGRAM_TABLE_INITIAL_CAPACITY;
+            NgramEntry* new_entries = (NgramEntry*)realloc(model->entries, (size_t)new_capacity * sizeof(NgramEntry));
+            if (!new_entries) return 0;
+            model->entries = new_entries;
+            model->capacity = new_capacity;
+        }
+        NgramEntry* e = &model->entries[model->count];
+        memset(e, 0, sizeof(*e));
+        memcpy(e->ids, ids, (size_t)n * sizeof(int));
+        e->n = n;
+        e->best_next = NO_PATTERN;
+        e->last_song = -1;
+        model->slots[slot] = model->count++;
+    }
+    NgramEntry* e = &model->entries[model->slots[slot]];
+    e->count++;
+    if (e->last_song != song) {
+        e->last_song = song;
+        e->song_count++;
+    }
+    return 1;
+}
+
+void freeTransitionModel() {
+    free(g_transitions.entries);
+    free(g_transitions.slots);
+    free(g_transitions.songs);
+    memset(&g_transitions, 0, sizeof(g_transitions));
+}
+
+/**
+ * @brief Builds unigram, bigram and trigram statistics over every loaded song.
+ *        Each (n-1)-gram learns its most frequent successor from the n-grams that
+ *        extend it, and each n-gram gets the list of songs containing it.
+ * @return 1 on success, 0 on allocation failure.
+ */
+int buildTransitionModel() {
+    freeTransitionModel();
+    TransitionModel* model = &g_transitions;
+    for (int s = 0; s < g_song_count; s++) {
+        const PatternSequence* seq = &g_songs[s].sequence;
+        for (int i = 0; i < seq->length; i++) {
+            for (int n = 1; n <= 3 && i + n <= seq->length; n++) {
+                if (!countNgram(model, &seq->ids[i], n, s)) { freeTransitionModel(); return 0; }
+            }
         }
-        while(token != NULL) {
-            add_pattern_to_list(&g_song_pattern_heads[song_idx], token);
-            token = strtok(NULL, ",");
+    }
+
+    // Successors: an n-gram (n >= 2) votes for its last ID as the next pattern of its prefix
+    for (int i = 0; i < model->count; i++) {
+        const NgramEntry* e = &model->entries[i];
+        if (e->n < 2) continue;
+        NgramEntry* prefix = &model->entries[model->slots[findNgramSlot(model, e->ids, e->n - 1)]];
+        if (e->count > prefix->best_next_count) {
+            prefix->best_next = e->ids[e->n - 1];
+            prefix->best_next_count = e->count;
         }
-        song_idx++;
     }
-    fclose(file);
+
+    // Song lists: size each slice, then fill them in song order
+    int total = 0;
+    for (int i = 0; i < model->count; i++) {
+        model->entries[i].song_first = total;
+        total += model->entries[i].song_count;
+        model->entries[i].song_count = 0;
+        model->entries[i].last_song = -1;
+    }
+    model->songs = (int*)malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (!model->songs) { freeTransitionModel(); return 0; }
+    for (int s = 0; s < g_song_count; s++) {
+        const PatternSequence* seq = &g_songs[s].sequence;
+        for (int i = 0; i < seq->length; i++) {
+            for (int n = 1; n <= 3 && i + n <= seq->length; n++) {
+                NgramEntry* e = &model->entries[model->slots[findNgramSlot(model, &seq->ids[i], n)]];
+                if (e->last_song == s) continue;
+                e->last_song = s;
+                model->songs[e->song_first + e->song_count++] = s;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the pattern most often following `ids` (one or two patterns), or NO_PATTERN.
+ */
+int mostLikelyNext(const int* ids, int n) {
+    const NgramEntry* e = findNgram(ids, n);
+    return e ? e->best_next : NO_PATTERN;
+}
+
+// --- Fuzzy Answer Matching ---
+/**
+ * @brief Lowercases `guess` (without surrounding spaces) and builds its Peq table.
+ */
+void prepareFuzzyQuery(FuzzyQuery* q, const char* guess) {
+    while (*guess == ' ') guess++;
+    size_t len = strlen(guess);
+    while (len > 0 && guess[len - 1] == ' ') len--;
+    if (len >= sizeof(q->key)) len = sizeof(q->key) - 1;
+    for (size_t i = 0; i < len; i++) q->key[i] = (char)tolower((unsigned char)guess[i]);
+    q->key[len] = '\0';
+    q->length = (int)len;
+    if (q->length > FUZZY_WORD_BITS) return;
+    memset(q->peq, 0, sizeof(q->peq));
+    for (int i = 0; i < q->length; i++) q->peq[(unsigned char)q->key[i]] |= 1ULL << i;
+}
+
+/**
+ * @brief Plain dynamic-programming edit distance, for guesses too long for one word.
+ */
+static int editDistanceDP(const char* a, int m, const char* b, int n, int max) {
+    int* row = (int*)malloc((size_t)(m + 1) * sizeof(int));
+    if (!row) return max + 1;
+    for (int i = 0; i <= m; i++) row[i] = i;
+    for (int j = 1; j <= n; j++) {
+        int diag = row[0], best = j;
+        row[0] = j;
+        for (int i = 1; i <= m; i++) {
+            int up = row[i];
+            int cost = diag + (a[i - 1] != b[j - 1]);
+            if (up + 1 < cost) cost = up + 1;
+            if (row[i - 1] + 1 < cost) cost = row[i - 1] + 1;
+            row[i] = cost;
+            diag = up;
+            if (cost < best) best = cost;
+        }
+        if (best > max) { free(row); return max + 1; } // Every path already costs too much
+    }
+    int d = row[m];
+    free(row);
+    return d;
+}
+
+/**
+ * @brief Edit distance (insert/delete/substitute) between the query and a
+ *        lowercased `key`, or max + 1 if it exceeds `max`. Uses Myers'
+ *        bit-parallel algorithm: one column of the DP matrix per key byte in a
+ *        handful of word operations, stopping once the distance cannot come back
+ *        under the bound.
+ */
+int fuzzyDistance(const FuzzyQuery* q, const char* key, int max) {
+    int m = q->length;
+    int n = (int)strlen(key);
+    if (n - m > max || m - n > max) return max + 1;
+    if (m == 0) return n;
+    if (m > FUZZY_WORD_BITS) {
+        int d = editDistanceDP(q->key, m, key, n, max);
+        return d > max ? max + 1 : d;
+    }
+    uint64_t pv = m == 64 ? ~0ULL : (1ULL << m) - 1;
+    uint64_t mv = 0;
+    uint64_t high = 1ULL << (m - 1);
+    int score = m;
+    for (int j = 0; j < n; j++) {
+        uint64_t eq = q->peq[(unsigned char)key[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & high) score++;
+        else if (mh & high) score--;
+        ph = (ph << 1) | 1; // Row 0 is D[0][j] = j, so every column starts one higher
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (score - (n - 1 - j) > max) return max + 1;
+    }
+    return score > max ? max + 1 : score;
+}
+
+/**
+ * @brief Typos tolerated when answering with a name of `length` letters.
+ */
+int allowedTypos(int length) {
+    int typos = length / 4;
+    return typos > FUZZY_MAX_TYPOS ? FUZZY_MAX_TYPOS : typos;
+}
+
+/**
+ * @brief Finds the database pattern closest to the query within its typo budget.
+ * @return The pattern's ID, or NO_PATTERN if none is close enough.
+ */
+int suggestPattern(const FuzzyQuery* q, int* distance) {
+    int best = NO_PATTERN, best_distance = 0;
+    for (int i = 0; i < g_pattern_count; i++) {
+        const char* key = patternKey(g_pattern_db[i].id);
+        int max = allowedTypos((int)strlen(key));
+        if (best != NO_PATTERN && best_distance - 1 < max) max = best_distance - 1; // Only look for better
+        if (max < 0) continue;
+        int d = fuzzyDistance(q, key, max);
+        if (d <= max) {
+            best = g_pattern_db[i].id;
+            best_distance = d;
+            if (d == 0) break;
+        }
+    }
+    if (distance) *distance = best_distance;
+    return best;
 }
 
 int runPatternQuiz() {
@@ -290,12 +771,23 @@ int runPatternQuiz() {
         fgets(user_guess, sizeof(user_guess), stdin);
         user_guess[strcspn(user_guess, "\n")] = 0;
         
-        // FIX: Using my_stricmp instead of non-standard stricmp
-        if (my_stricmp(user_guess, p_q->name) == 0) {
+        FuzzyQuery query;
+        prepareFuzzyQuery(&query, user_guess);
+        const char* answer_key = patternKey(p_q->id);
+        // Naming another pattern exactly is a wrong answer, even if it is one typo away
+        int named = lookupPattern(query.key, (size_t)query.length);
+        int allowed = named != NO_PATTERN && named != p_q->id ? 0 : allowedTypos((int)strlen(answer_key));
+        int typos = fuzzyDistance(&query, answer_key, allowed);
+        if (typos == 0) {
             printf("Correct!\n");
             score++;
+        } else if (typos <= allowed) {
+            printf("Correct! (Close enough - it is spelled '%s'.)\n", p_q->name);
+            score++;
         } else {
             printf("Incorrect. The correct answer was: %s\n", p_q->name);
+            int suggestion = named == NO_PATTERN ? suggestPattern(&query, NULL) : NO_PATTERN;
+            if (suggestion != NO_PATTERN && query.length > 0) printf("(Your answer looks like '%s'.)\n", patternName(suggestion));
         }
     }
     return score;
@@ -305,26 +797,26 @@ void playPatternChainGame() {
     clear_screen();
     printf("\n--- Bonus Game: Complete the Choreography Chain! ---\n");
     printf("Select a song to practice:\n");
-    for(int i=0; i<NUM_SONGS; i++) {
-        if(g_song_pattern_heads[i] != NULL)
-            printf("  %d. %s\n", i+1, g_song_titles[i]);
+    for(int i=0; i<g_song_count && i<SONG_LIST_PREVIEW; i++) {
+        printf("  %d. %s\n", i+1, songTitle(&g_songs[i]));
     }
+    if(g_song_count > SONG_LIST_PREVIEW) printf("  ... and %d more (1-%d)\n", g_song_count - SONG_LIST_PREVIEW, g_song_count);
     
-    char buffer[10];
+    char buffer[16];
     printf("Choice: ");
     fgets(buffer, sizeof(buffer), stdin);
     int choice = atoi(buffer);
-    if(choice < 1 || choice > NUM_SONGS || g_song_pattern_heads[choice-1] == NULL) {
+    if(choice < 1 || choice > g_song_count || g_songs[choice-1].sequence.length == 0) {
         printf("Invalid choice.\n");
         return;
     }
     
-    PatternNode* current_node = g_song_pattern_heads[choice - 1];
+    const PatternSequence* seq = &g_songs[choice - 1].sequence;
     
-    while(current_node != NULL) {
-        printf("\nCurrent Pattern: [%s]\n", current_node->pattern_name);
-        if(current_node->next == NULL) {
-            printf("\n*** Congratulations! You completed the entire chain for %s! ***\n", g_song_titles[choice - 1]);
+    for(int step = 0; step < seq->length; step++) {
+        printf("\nCurrent Pattern: [%s]\n", patternName(seq->ids[step]));
+        if(step + 1 == seq->length) {
+            printf("\n*** Congratulations! You completed the entire chain for %s! ***\n", songTitle(&g_songs[choice - 1]));
             break;
         }
         
@@ -333,11 +825,11 @@ void playPatternChainGame() {
         fgets(user_guess, sizeof(user_guess), stdin);
         user_guess[strcspn(user_guess, "\n")] = 0;
 
-        if(my_stricmp(user_guess, current_node->next->pattern_name) == 0) {
+        int next_id = seq->ids[step + 1];
+        if(lookupPattern(user_guess, strlen(user_guess)) == next_id) {
             printf("Correct! Moving to the next step.\n");
-            current_node = current_node->next;
         } else {
-            printf("Incorrect. The next pattern was '%s'. Game over.\n", current_node->next->pattern_name);
+            printf("Incorrect. The next pattern was '%s'. Game over.\n", patternName(next_id));
             break;
         }
     }
@@ -363,11 +855,12 @@ void learnDancePattern() {
         load_analyzed_patterns();
         
         printf("\n--- Analyzed Choreography Sequences ---\n");
-        for(int i=0; i<NUM_SONGS; i++) {
-            if(g_song_pattern_heads[i] == NULL) continue;
-            printf("%-20s: ", g_song_titles[i]);
-            display_pattern_list(g_song_pattern_heads[i]);
+        for(int i=0; i<g_song_count && i<SONG_LIST_PREVIEW; i++) {
+            if(g_songs[i].sequence.length == 0) continue;
+            printf("%-20s: ", songTitle(&g_songs[i]));
+            display_pattern_list(&g_songs[i].sequence);
         }
+        if(g_song_count > SONG_LIST_PREVIEW) printf("... and %d more song(s)\n", g_song_count - SONG_LIST_PREVIEW);
 
         playPatternChainGame();
 
@@ -379,6 +872,65 @@ void learnDancePattern() {
     getchar();
 }
 
+/**
+ * @brief Interactive queries against the transition model. One or two patterns
+ *        give the most likely next pattern; two or three give the songs that
+ *        contain that exact run of patterns.
+ */
+void exploreTransitions() {
+    clear_screen();
+    printf("========================================\n");
+    printf("   C. Choreography Transition Explorer\n");
+    printf("========================================\n");
+    load_dance_patterns();
+    load_analyzed_patterns();
+    if (g_transitions.count == 0 && !buildTransitionModel()) {
+        perror("Failed to build the transition model");
+        return;
+    }
+    printf("%d song(s), %d distinct n-gram(s).\n", g_song_count, g_transitions.count);
+
+    char line[512];
+    while (1) {
+        printf("\nEnter 1-3 patterns separated by commas (empty to go back): ");
+        if (!fgets(line, sizeof(line), stdin)) break;
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] == '\0') break;
+
+        int ids[3];
+        int n = 0, unknown = 0;
+        for (char* token = strtok(line, ","); token; token = strtok(NULL, ",")) {
+            while (*token == ' ') token++;
+            size_t len = strlen(token);
+            while (len > 0 && token[len - 1] == ' ') len--;
+            if (len == 0) continue;
+            if (n == 3) { n = 4; break; }
+            int id = lookupPattern(token, len);
+            if (id == NO_PATTERN) { printf("Unknown pattern: %.*s\n", (int)len, token); unknown = 1; }
+            ids[n++] = id;
+        }
+        if (unknown) continue;
+        if (n == 0 || n > 3) { printf("Please enter between 1 and 3 patterns.\n"); continue; }
+
+        const NgramEntry* e = findNgram(ids, n);
+        if (!e) { printf("No song contains that sequence.\n"); continue; }
+        if (n < 3) {
+            if (e->best_next != NO_PATTERN) {
+                printf("Most likely next: %s (%d of %d time(s))\n", patternName(e->best_next), e->best_next_count, e->count);
+            } else {
+                printf("Nothing follows this sequence in any song.\n");
+            }
+        }
+        if (n >= 2) {
+            printf("Found in %d song(s):\n", e->song_count);
+            for (int i = 0; i < e->song_count && i < SONG_LIST_PREVIEW; i++) {
+                printf("  - %s\n", songTitle(&g_songs[g_transitions.songs[e->song_first + i]]));
+            }
+            if (e->song_count > SONG_LIST_PREVIEW) printf("  ... and %d more\n", e->song_count - SONG_LIST_PREVIEW);
+        }
+    }
+}
+
 /**
  * @brief Frees all dynamically allocated memory at program exit.
  */
@@ -387,12 +939,15 @@ void cleanup_stage5_data() {
         free(g_pattern_db);
         g_pattern_db = NULL;
     }
-    for (int i=0; i<NUM_SONGS; i++) {
-        PatternNode *current = g_song_pattern_heads[i], *next;
-        while(current != NULL) {
-            next = current->next;
-            free(current);
-            current = next;
-        }
-    }
+    for (int i=0; i<g_song_count; i++) free(g_songs[i].sequence.ids);
+    free(g_songs);
+    g_songs = NULL;
+    g_song_count = g_song_capacity = 0;
+    freeTransitionModel();
+    free(g_text_pool.data);
+    free(g_pattern_names.name_off);
+    free(g_pattern_names.key_off);
+    free(g_pattern_names.slots);
+    memset(&g_text_pool, 0, sizeof(g_text_pool));
+    memset(&g_pattern_names, 0, sizeof(g_pattern_names));
 }
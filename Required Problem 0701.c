@@ -3,8 +3,9 @@
  * @brief A self-contained version of the "Finding People" job posting feature for online compilers.
  *
  * This program combines all necessary functions into a single file. It manages
- * job postings using a dynamic array, which grows as needed. It includes a
- * fallback for file I/O to ensure it runs correctly in online environments.
+ * job postings using a dynamic array, which grows as needed. Postings are
+ * persisted to a versioned binary file that is loaded in a single pass at startup.
+ * Social network posts are queued and delivered by a background worker thread.
  * The bonus feature for filtering active vs. expired posts is fully implemented.
  */
 
@@ -13,11 +14,37 @@
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 // --- Constants and Data Structures ---
 #define INITIAL_CAPACITY 10
-#define FILENAME "job_postings.csv"
+#define ARENA_INITIAL_CAPACITY 4096
+#define FILENAME "job_postings.dat"
+#define FILENAME_TMP "job_postings.dat.tmp"
+#define POSTING_FILE_MAGIC "JPDB"
+#define POSTING_FILE_VERSION 1
+#define SAVE_BUFFER_SIZE (1 << 16)
+#define MAX_ID_SLOTS_PER_POSTING 1024 // Loaded IDs beyond this much sparsity mark the file as corrupt
+#define DAY_NUMBER_INVALID (-1000000000) // Sorts before every real date, so malformed deadlines read as expired
 #define NUM_MEMBERS 4 // Assumed from context
+#define TERM_TABLE_INITIAL_CAPACITY 256 // Must be a power of two
+#define MAX_TERM_LENGTH 32
+#define MAX_QUERY_TERMS 16
+#define SEARCH_RESULT_LIMIT 50
+#define NUM_SOCIAL_NETWORKS 5
+#define OUTBOUND_QUEUE_CAPACITY 1024 // Pending posts per network
+#define OUTBOUND_BATCH_SIZE 32       // Max posts written to a network sink at once
+#define OUTBOUND_MESSAGE_LENGTH 256
+#define DEFAULT_POSTS_PER_SECOND 10  // Per network; adjustable from the social menu
+#define OUTBOX_FILE_FORMAT "outbox_%s.log"
 
 // Holds a single job posting with a dynamic list of qualifications
 typedef struct {
@@ -27,10 +54,68 @@ typedef struct {
     char deadline[11];     // YYYY-MM-DD
     int num_to_hire;
     char job_field[100];
-    char** qualifications; // Dynamic array of strings
+    int qual_first;        // Index of the first qualification in g_qual_offsets
     int qualifications_count;
+    int deadline_day;      // Deadline as days since 1970-01-01 (see date_to_day_number)
 } JobPosting;
 
+/*
+ * On-disk layout (native byte order):
+ *   PostingFileHeader
+ *   PostingFileRecord[record_count]
+ *   uint32_t qualification offsets[qual_count]   (into the string blob)
+ *   char string blob[blob_size]                  (NUL-terminated strings)
+ */
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_count;
+    uint32_t qual_count;
+    uint32_t blob_size;
+    int32_t next_id;
+} PostingFileHeader;
+
+typedef struct {
+    int32_t id;
+    int32_t num_to_hire;
+    char posting_date[11];
+    char deadline[11];
+    uint32_t title_off;
+    uint32_t field_off;
+    uint32_t qual_first; // Index of the first entry in the offset table
+    uint32_t qual_count;
+} PostingFileRecord;
+
+// One term of the search index with its posting list of job IDs
+typedef struct {
+    char* term; // NULL marks an empty bucket
+    int* ids;
+    int count;
+    int capacity;
+} TermEntry;
+
+// A social post rendered at enqueue time, so the worker never reads g_job_postings
+typedef struct {
+    int posting_id;
+    char message[OUTBOUND_MESSAGE_LENGTH];
+} OutboundPost;
+
+// Bounded ring of pending posts for one network
+typedef struct {
+    OutboundPost items[OUTBOUND_QUEUE_CAPACITY];
+    int head;
+    int count;
+    long delivered;
+    long failed;                // Posts dropped because the sink could not be written
+    struct timespec next_ready; // Earliest time the next batch may go out (CLOCK_MONOTONIC)
+} NetworkQueue;
+
+// A posting that matched a search, with the number of distinct query terms it matched
+typedef struct {
+    int id;
+    int matches;
+} SearchHit;
+
 
 // --- Global Data Storage ---
 JobPosting* g_job_postings = NULL;
@@ -38,6 +123,46 @@ int g_post_count = 0;
 int g_post_capacity = 0;
 int g_next_id = 1;
 
+// Slot indices into g_job_postings ordered by deadline_day (ties keep insertion order).
+// Sized alongside g_job_postings, so it always has g_post_capacity entries.
+int* g_deadline_index = NULL;
+
+// Dense id -> slot table (-1 = no posting). IDs come from the monotonic g_next_id,
+// so the table stays proportional to the number of postings ever created.
+int* g_id_slots = NULL;
+int g_id_slots_capacity = 0;
+
+// Inverted index over job fields and qualifications: an open-addressing
+// (linear probing) hash table from lowercase term to posting list.
+TermEntry* g_term_table = NULL;
+int g_term_table_capacity = 0;
+int g_term_count = 0;
+
+// Outbound social queue, shared by the menu thread (producer) and one worker (consumer)
+const char* g_social_networks[NUM_SOCIAL_NETWORKS] = {"Facebook", "Instagram", "Threads", "LinkedIn", "X"};
+NetworkQueue g_outbound[NUM_SOCIAL_NETWORKS];
+pthread_mutex_t g_outbound_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t g_outbound_cond;
+pthread_t g_outbound_worker;
+int g_outbound_started = 0;
+int g_outbound_stopping = 0;
+int g_posts_per_second = DEFAULT_POSTS_PER_SECOND;
+
+// Table-wide string arena. Qualifications are NUL-terminated strings bump-allocated
+// from g_string_arena and addressed through g_qual_offsets; each posting owns the
+// contiguous run [qual_first, qual_first + qualifications_count). The layout matches
+// the file's offset table and blob, so loading is a pair of block copies.
+char* g_string_arena = NULL;
+size_t g_arena_size = 0;
+size_t g_arena_capacity = 0;
+uint32_t* g_qual_offsets = NULL;
+int g_qual_count = 0;
+int g_qual_capacity = 0;
+
+// File image, only held while load_postings() runs
+char* g_db_image = NULL;
+size_t g_db_image_size = 0;
+
 
 // --- Forward Declarations for All Functions ---
 void clear_screen();
@@ -48,6 +173,8 @@ void show_visual_menu();
 void findSpecialist();
 void load_postings();
 void save_postings();
+void index_posting(const JobPosting* posting);
+void search_postings();
 
 
 // --- Main Entry Point ---
@@ -148,28 +275,183 @@ void get_current_date_str(char* buffer) {
     strftime(buffer, 11, "%Y-%m-%d", t);
 }
 
+/**
+ * @brief  Converts a "YYYY-MM-DD" string to a day number (days since 1970-01-01).
+ * @return The day number, or DAY_NUMBER_INVALID if the string is not a valid date.
+ */
+int date_to_day_number(const char* date) {
+    int y, m, d;
+    char tail;
+    if (sscanf(date, "%4d-%2d-%2d%c", &y, &m, &d, &tail) != 3 || m < 1 || m > 12 || d < 1 || d > 31) {
+        return DAY_NUMBER_INVALID;
+    }
+    // Civil-from-days inverse over 400-year eras, with March as the first month.
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+/**
+ * @brief  Returns the first position in g_deadline_index whose deadline is >= day.
+ */
+int deadline_lower_bound(int day) {
+    int lo = 0, hi = g_post_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (g_job_postings[g_deadline_index[mid]].deadline_day < day) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief  Inserts an already-stored posting slot into the deadline index, after any equal deadlines.
+ */
+void deadline_index_insert(int slot) {
+    int day = g_job_postings[slot].deadline_day;
+    int lo = 0, hi = slot; // The index holds exactly the slots before this one
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (g_job_postings[g_deadline_index[mid]].deadline_day <= day) lo = mid + 1;
+        else hi = mid;
+    }
+    memmove(&g_deadline_index[lo + 1], &g_deadline_index[lo], (size_t)(slot - lo) * sizeof(int));
+    g_deadline_index[lo] = slot;
+}
+
+static int compare_slots_by_deadline(const void* a, const void* b) {
+    int sa = *(const int*)a, sb = *(const int*)b;
+    int da = g_job_postings[sa].deadline_day, db = g_job_postings[sb].deadline_day;
+    if (da != db) return da < db ? -1 : 1;
+    return sa - sb;
+}
+
+/**
+ * @brief  Rebuilds the whole deadline index in one sort (used after a bulk load).
+ */
+void deadline_index_rebuild() {
+    for (int i = 0; i < g_post_count; i++) g_deadline_index[i] = i;
+    qsort(g_deadline_index, g_post_count, sizeof(int), compare_slots_by_deadline);
+}
+
+/**
+ * @brief  Records that posting `id` lives at `slot`, growing the id table if needed.
+ * @return 1 on success, 0 on allocation failure, overflow or an invalid id.
+ */
+int id_slots_set(int id, int slot) {
+    if (id <= 0) return 0;
+    if (id >= g_id_slots_capacity) {
+        int new_capacity = g_id_slots_capacity ? g_id_slots_capacity : INITIAL_CAPACITY;
+        while (new_capacity <= id) {
+            if (new_capacity > INT_MAX / 2) return 0;
+            new_capacity *= 2;
+        }
+        int* new_slots = (int*)realloc(g_id_slots, (size_t)new_capacity * sizeof(int));
+        if (!new_slots) return 0;
+        for (int i = g_id_slots_capacity; i < new_capacity; i++) new_slots[i] = -1;
+        g_id_slots = new_slots;
+        g_id_slots_capacity = new_capacity;
+    }
+    g_id_slots[id] = slot;
+    return 1;
+}
+
+/**
+ * @brief  Finds a posting by its ID in constant time.
+ * @return A pointer into g_job_postings, or NULL if no such posting exists.
+ */
+JobPosting* find_posting_by_id(int id) {
+    if (id <= 0 || id >= g_id_slots_capacity || g_id_slots[id] < 0) return NULL;
+    return &g_job_postings[g_id_slots[id]];
+}
+
+/**
+ * @brief  Returns qualification `q` of a posting.
+ */
+const char* posting_qualification(const JobPosting* posting, int q) {
+    return g_string_arena + g_qual_offsets[posting->qual_first + q];
+}
+
+/**
+ * @brief  Ensures the arena and offset table can hold `extra_bytes` and `extra_quals` more.
+ * @return 1 on success, 0 on allocation failure (existing data is untouched).
+ */
+int arena_reserve(size_t extra_bytes, int extra_quals) {
+    if (g_arena_size + extra_bytes > g_arena_capacity) {
+        size_t new_capacity = g_arena_capacity ? g_arena_capacity : ARENA_INITIAL_CAPACITY;
+        while (new_capacity < g_arena_size + extra_bytes) new_capacity *= 2;
+        char* new_arena = (char*)realloc(g_string_arena, new_capacity);
+        if (!new_arena) return 0;
+        g_string_arena = new_arena;
+        g_arena_capacity = new_capacity;
+    }
+    if (g_qual_count + extra_quals > g_qual_capacity) {
+        int new_capacity = g_qual_capacity ? g_qual_capacity : INITIAL_CAPACITY;
+        while (new_capacity < g_qual_count + extra_quals) new_capacity *= 2;
+        uint32_t* new_offsets = (uint32_t*)realloc(g_qual_offsets, new_capacity * sizeof(uint32_t));
+        if (!new_offsets) return 0;
+        g_qual_offsets = new_offsets;
+        g_qual_capacity = new_capacity;
+    }
+    return 1;
+}
+
+/**
+ * @brief  Appends a qualification string to the arena.
+ * @return 1 on success, 0 on allocation failure.
+ */
+int arena_add_qualification(const char* text) {
+    size_t len = strlen(text) + 1;
+    if (g_arena_size + len > UINT32_MAX || !arena_reserve(len, 1)) return 0;
+    memcpy(g_string_arena + g_arena_size, text, len);
+    g_qual_offsets[g_qual_count++] = (uint32_t)g_arena_size;
+    g_arena_size += len;
+    return 1;
+}
+
+/**
+ * @brief  Drops every qualification from index `qual_first` onwards (the tail of the arena).
+ */
+void arena_truncate(int qual_first) {
+    if (qual_first >= g_qual_count) return;
+    g_arena_size = g_qual_offsets[qual_first];
+    g_qual_count = qual_first;
+}
+
 /**
  * @brief  Adds a new job posting to the global dynamic array, resizing if needed.
  */
 void add_posting_to_db(JobPosting new_posting) {
+    int stored = 1;
     if (g_post_count == g_post_capacity) {
-        g_post_capacity = (g_post_capacity == 0) ? INITIAL_CAPACITY : g_post_capacity * 2;
-        JobPosting* new_db = (JobPosting*)realloc(g_job_postings, g_post_capacity * sizeof(JobPosting));
-        if (!new_db) {
-            perror("Failed to reallocate memory for job postings");
-            // In case of realloc failure, the original block is still valid.
-            // We can't add the new post, but the old data is safe.
-            // Free the qualifications memory for the post that couldn't be added.
-            for(int i = 0; i < new_posting.qualifications_count; i++) {
-                free(new_posting.qualifications[i]);
-            }
-            free(new_posting.qualifications);
-            return;
+        int new_capacity = (g_post_capacity == 0) ? INITIAL_CAPACITY : g_post_capacity * 2;
+        int* new_index = (int*)realloc(g_deadline_index, new_capacity * sizeof(int));
+        if (new_index) g_deadline_index = new_index;
+        JobPosting* new_db = new_index ? (JobPosting*)realloc(g_job_postings, new_capacity * sizeof(JobPosting)) : NULL;
+        if (new_db) {
+            g_job_postings = new_db;
+            g_post_capacity = new_capacity;
+        } else {
+            stored = 0;
         }
-        g_job_postings = new_db;
     }
-    g_job_postings[g_post_count++] = new_posting;
+    if (!stored || !id_slots_set(new_posting.id, g_post_count)) {
+        perror("Failed to reallocate memory for job postings");
+        // In case of realloc failure, the original block is still valid.
+        // We can't add the new post, but the old data is safe.
+        // Release the arena space taken by the post that couldn't be added.
+        arena_truncate(new_posting.qual_first);
+        return;
+    }
+    new_posting.deadline_day = date_to_day_number(new_posting.deadline);
+    g_job_postings[g_post_count] = new_posting;
+    deadline_index_insert(g_post_count);
+    g_post_count++;
     g_next_id++;
+    index_posting(&g_job_postings[g_post_count - 1]);
 }
 
 /**
@@ -186,13 +468,20 @@ void create_job_posting() {
     fgets(new_post.title, sizeof(new_post.title), stdin);
     new_post.title[strcspn(new_post.title, "\n")] = 0;
     
+    // Dates go through the larger buffer so the trailing newline of a full
+    // 10-character date is consumed instead of leaking into the next prompt.
     printf("Posting Date (YYYY-MM-DD): ");
-    fgets(new_post.posting_date, sizeof(new_post.posting_date), stdin);
-    new_post.posting_date[strcspn(new_post.posting_date, "\n")] = 0;
+    fgets(buffer, sizeof(buffer), stdin);
+    buffer[strcspn(buffer, "\n")] = 0;
+    snprintf(new_post.posting_date, sizeof(new_post.posting_date), "%.10s", buffer);
 
     printf("Deadline (YYYY-MM-DD): ");
-    fgets(new_post.deadline, sizeof(new_post.deadline), stdin);
-    new_post.deadline[strcspn(new_post.deadline, "\n")] = 0;
+    fgets(buffer, sizeof(buffer), stdin);
+    buffer[strcspn(buffer, "\n")] = 0;
+    snprintf(new_post.deadline, sizeof(new_post.deadline), "%.10s", buffer);
+    if (date_to_day_number(new_post.deadline) == DAY_NUMBER_INVALID) {
+        printf("Warning: '%s' is not a valid date; the posting will be listed as expired.\n", new_post.deadline);
+    }
 
     printf("Number of Hires: ");
     fgets(buffer, sizeof(buffer), stdin);
@@ -202,7 +491,7 @@ void create_job_posting() {
     fgets(new_post.job_field, sizeof(new_post.job_field), stdin);
     new_post.job_field[strcspn(new_post.job_field, "\n")] = 0;
 
-    new_post.qualifications = NULL;
+    new_post.qual_first = g_qual_count;
     new_post.qualifications_count = 0;
     printf("Enter qualifications (type 'done' on a new line to finish):\n");
     while(1) {
@@ -211,9 +500,11 @@ void create_job_posting() {
         buffer[strcspn(buffer, "\n")] = 0;
         if(strcmp(buffer, "done") == 0) break;
         
+        if (!arena_add_qualification(buffer)) {
+            perror("Failed to store qualification");
+            continue;
+        }
         new_post.qualifications_count++;
-        new_post.qualifications = (char**)realloc(new_post.qualifications, new_post.qualifications_count * sizeof(char*));
-        new_post.qualifications[new_post.qualifications_count - 1] = strdup(buffer);
     }
 
     add_posting_to_db(new_post);
@@ -240,16 +531,15 @@ void view_job_postings(int show_expired) {
     printf("%-5s | %-30s | %-12s | %-12s\n", "ID", "Title", "Post Date", "Deadline");
     printf("---------------------------------------------------------------------\n");
 
-    int display_count = 0;
-    for (int i = 0; i < g_post_count; i++) {
-        // A date is expired if it's less than the current date
-        int is_expired = strcmp(g_job_postings[i].deadline, current_date) < 0;
-        if ((show_expired && is_expired) || (!show_expired && !is_expired)) {
-            printf("%-5d | %-30.30s | %-12s | %-12s\n", 
-                g_job_postings[i].id, g_job_postings[i].title, 
-                g_job_postings[i].posting_date, g_job_postings[i].deadline);
-            display_count++;
-        }
+    // A posting is expired if its deadline is before today, so the index splits
+    // into [0, split) expired and [split, g_post_count) active, both in deadline order.
+    int split = deadline_lower_bound(date_to_day_number(current_date));
+    int begin = show_expired ? 0 : split;
+    int end = show_expired ? split : g_post_count;
+    int display_count = end - begin;
+    for (int k = begin; k < end; k++) {
+        const JobPosting* p = &g_job_postings[g_deadline_index[k]];
+        printf("%-5d | %-30.30s | %-12s | %-12s\n", p->id, p->title, p->posting_date, p->deadline);
     }
     if (display_count == 0) printf("No %s postings found.\n", show_expired ? "expired" : "active");
     
@@ -259,71 +549,749 @@ void view_job_postings(int show_expired) {
     int id_choice = atoi(buffer);
     if(id_choice == 0) return;
 
-    for(int i=0; i<g_post_count; i++) {
-        if(g_job_postings[i].id == id_choice) {
-            printf("\n--- Details for Job #%d ---\n", id_choice);
-            printf("Title: %s\n", g_job_postings[i].title);
-            printf("Field: %s\n", g_job_postings[i].job_field);
-            printf("Positions Available: %d\n", g_job_postings[i].num_to_hire);
-            printf("Post Date: %s | Deadline: %s\n", g_job_postings[i].posting_date, g_job_postings[i].deadline);
-            printf("Qualifications:\n");
-            for(int q=0; q < g_job_postings[i].qualifications_count; q++) {
-                printf("  - %s\n", g_job_postings[i].qualifications[q]);
-            }
-            return;
+    const JobPosting* p = find_posting_by_id(id_choice);
+    if (p == NULL) {
+        printf("Posting with ID #%d not found.\n", id_choice);
+        return;
+    }
+    printf("\n--- Details for Job #%d ---\n", id_choice);
+    printf("Title: %s\n", p->title);
+    printf("Field: %s\n", p->job_field);
+    printf("Positions Available: %d\n", p->num_to_hire);
+    printf("Post Date: %s | Deadline: %s\n", p->posting_date, p->deadline);
+    printf("Qualifications:\n");
+    for(int q=0; q < p->qualifications_count; q++) {
+        printf("  - %s\n", posting_qualification(p, q));
+    }
+}
+
+// --- Outbound Social Queue ---
+
+static void timespec_add_ns(struct timespec* t, long long ns) {
+    ns += t->tv_nsec;
+    t->tv_sec += (time_t)(ns / 1000000000LL);
+    t->tv_nsec = (long)(ns % 1000000000LL);
+}
+
+static int timespec_before(const struct timespec* a, const struct timespec* b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+/**
+ * @brief Appends a batch of posts to a network's local sink, which stands in for its API.
+ * @return 1 if the whole batch was written, 0 if the sink could not be opened or written.
+ */
+static int deliver_batch(int network, const OutboundPost* batch, int count) {
+    char path[64];
+    char name[32];
+    int len = 0;
+    for (const char* c = g_social_networks[network]; *c && len < (int)sizeof(name) - 1; c++) {
+        name[len++] = (char)tolower((unsigned char)*c);
+    }
+    name[len] = '\0';
+    snprintf(path, sizeof(path), OUTBOX_FILE_FORMAT, name);
+    FILE* sink = fopen(path, "a");
+    if (!sink) return 0; // The worker has no terminal to report to; the caller counts the failure
+    for (int i = 0; i < count; i++) {
+        fprintf(sink, "#%d\t%s\n", batch[i].posting_id, batch[i].message);
+    }
+    int ok = !ferror(sink);
+    if (fclose(sink) != 0) ok = 0;
+    return ok;
+}
+
+/**
+ * @brief Worker thread: repeatedly sends the next batch from whichever non-empty
+ *        network becomes ready first, pacing each network to g_posts_per_second.
+ *        On shutdown the remaining posts are flushed without pacing.
+ */
+static void* outbound_worker(void* arg) {
+    (void)arg;
+    OutboundPost batch[OUTBOUND_BATCH_SIZE];
+    pthread_mutex_lock(&g_outbound_lock);
+    while (1) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int network = -1;
+        for (int n = 0; n < NUM_SOCIAL_NETWORKS; n++) {
+            if (g_outbound[n].count == 0) continue;
+            if (network < 0 || timespec_before(&g_outbound[n].next_ready, &g_outbound[network].next_ready)) network = n;
+        }
+        if (network < 0) {
+            if (g_outbound_stopping) break;
+            pthread_cond_wait(&g_outbound_cond, &g_outbound_lock);
+            continue;
+        }
+        NetworkQueue* queue = &g_outbound[network];
+        if (!g_outbound_stopping && timespec_before(&now, &queue->next_ready)) {
+            pthread_cond_timedwait(&g_outbound_cond, &g_outbound_lock, &queue->next_ready);
+            continue;
+        }
+
+        // A batch never exceeds one second's worth of the rate limit
+        int limit = g_posts_per_second < OUTBOUND_BATCH_SIZE ? g_posts_per_second : OUTBOUND_BATCH_SIZE;
+        int taken = 0;
+        while (taken < limit && queue->count > 0) {
+            batch[taken++] = queue->items[queue->head];
+            queue->head = (queue->head + 1) % OUTBOUND_QUEUE_CAPACITY;
+            queue->count--;
         }
+        queue->next_ready = now;
+        timespec_add_ns(&queue->next_ready, taken * 1000000000LL / g_posts_per_second);
+
+        pthread_mutex_unlock(&g_outbound_lock);
+        int ok = deliver_batch(network, batch, taken);
+        pthread_mutex_lock(&g_outbound_lock);
+        if (ok) queue->delivered += taken;
+        else queue->failed += taken;
+    }
+    pthread_mutex_unlock(&g_outbound_lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts the worker thread on first use. Must be called with g_outbound_lock held.
+ * @return 1 if the worker is running.
+ */
+static int outbound_start() {
+    if (g_outbound_started) return 1;
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_outbound_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    if (pthread_create(&g_outbound_worker, NULL, outbound_worker, NULL) != 0) {
+        pthread_cond_destroy(&g_outbound_cond);
+        return 0;
+    }
+    g_outbound_started = 1;
+    return 1;
+}
+
+/**
+ * @brief Queues one posting for one network without blocking on delivery.
+ * @return 1 if queued, 0 if that network's queue is full or the worker could not start.
+ */
+int outbound_enqueue(int network, const JobPosting* posting) {
+    OutboundPost post;
+    post.posting_id = posting->id;
+    snprintf(post.message, sizeof(post.message), "We're hiring: %s (%s) - %d position(s), apply by %s",
+             posting->title, posting->job_field, posting->num_to_hire, posting->deadline);
+
+    pthread_mutex_lock(&g_outbound_lock);
+    NetworkQueue* queue = &g_outbound[network];
+    int queued = outbound_start() && queue->count < OUTBOUND_QUEUE_CAPACITY;
+    if (queued) {
+        queue->items[(queue->head + queue->count) % OUTBOUND_QUEUE_CAPACITY] = post;
+        queue->count++;
+        pthread_cond_signal(&g_outbound_cond);
+    }
+    pthread_mutex_unlock(&g_outbound_lock);
+    return queued;
+}
+
+/**
+ * @brief Flushes every pending post and stops the worker thread.
+ */
+void outbound_shutdown() {
+    pthread_mutex_lock(&g_outbound_lock);
+    if (!g_outbound_started) {
+        pthread_mutex_unlock(&g_outbound_lock);
+        return;
     }
-    printf("Posting with ID #%d not found.\n", id_choice);
+    g_outbound_stopping = 1;
+    pthread_cond_signal(&g_outbound_cond);
+    pthread_mutex_unlock(&g_outbound_lock);
+    pthread_join(g_outbound_worker, NULL);
+    pthread_cond_destroy(&g_outbound_cond);
+    g_outbound_started = 0;
+}
+
+static void print_outbound_status() {
+    pthread_mutex_lock(&g_outbound_lock);
+    printf("Outbound queue (limit %d post(s)/sec per network):\n", g_posts_per_second);
+    for (int n = 0; n < NUM_SOCIAL_NETWORKS; n++) {
+        printf("  %-10s %4d pending, %6ld delivered, %4ld failed\n", g_social_networks[n],
+               g_outbound[n].count, g_outbound[n].delivered, g_outbound[n].failed);
+    }
+    pthread_mutex_unlock(&g_outbound_lock);
 }
 
 /**
- * @brief Stub function to simulate posting to social media.
+ * @brief Queues job postings for the social networks. Delivery happens in the
+ *        background, so the menu returns as soon as the posts are queued.
  */
 void post_to_social_media() {
-    const char* social_networks[] = {"Facebook", "Instagram", "Threads", "LinkedIn", "X"};
     printf("\n--- Post to Social Media ---\n");
-    if(g_post_count == 0) { printf("No job postings to share.\n"); return; }
+    print_outbound_status();
 
-    printf("Enter the ID of the job posting to share: ");
-    char buffer[10];
+    printf("\nEnter a posting ID to share, 'all' for every active posting, or 'rate' to change the rate limit: ");
+    char buffer[16];
     fgets(buffer, sizeof(buffer), stdin);
+    buffer[strcspn(buffer, "\n")] = 0;
+
+    if (strcmp(buffer, "rate") == 0) {
+        printf("Posts per second per network: ");
+        fgets(buffer, sizeof(buffer), stdin);
+        int rate = atoi(buffer);
+        if (rate <= 0) { printf("Invalid rate.\n"); return; }
+        pthread_mutex_lock(&g_outbound_lock);
+        g_posts_per_second = rate;
+        pthread_mutex_unlock(&g_outbound_lock);
+        printf("Rate limit set to %d post(s)/sec per network.\n", rate);
+        return;
+    }
+
+    if(g_post_count == 0) { printf("No job postings to share.\n"); return; }
+
+    // Postings to share form a range of the deadline index: one slot, or all active ones
+    int share_all = strcmp(buffer, "all") == 0;
     int id_choice = atoi(buffer);
-    
-    int post_exists = 0;
-    for(int i=0; i<g_post_count; i++) if(g_job_postings[i].id == id_choice) post_exists = 1;
+    const JobPosting* single = share_all ? NULL : find_posting_by_id(id_choice);
+    if(!share_all && single == NULL) { printf("Job posting #%d not found.\n", id_choice); return; }
 
-    if(!post_exists) { printf("Job posting #%d not found.\n", id_choice); return; }
+    char current_date[11];
+    get_current_date_str(current_date);
+    int begin = share_all ? deadline_lower_bound(date_to_day_number(current_date)) : 0;
+    int end = share_all ? g_post_count : 1;
+    if (begin == end) { printf("No active postings to share.\n"); return; }
 
     printf("Select a social network:\n");
-    for(int i=0; i<5; i++) printf("  %d. %s\n", i+1, social_networks[i]);
+    for(int i=0; i<NUM_SOCIAL_NETWORKS; i++) printf("  %d. %s\n", i+1, g_social_networks[i]);
+    printf("  %d. All networks\n", NUM_SOCIAL_NETWORKS + 1);
     printf("Choice: ");
     fgets(buffer, sizeof(buffer), stdin);
     int net_choice = atoi(buffer);
-
-    if(net_choice > 0 && net_choice <= 5) {
-        printf("\nPosting Job Ad #%d to %s...\n", id_choice, social_networks[net_choice - 1]);
-        printf("...Success!\n");
-    } else {
+    if (net_choice <= 0 || net_choice > NUM_SOCIAL_NETWORKS + 1) {
         printf("Invalid selection.\n");
+        return;
+    }
+    int first_net = net_choice <= NUM_SOCIAL_NETWORKS ? net_choice - 1 : 0;
+    int last_net = net_choice <= NUM_SOCIAL_NETWORKS ? net_choice - 1 : NUM_SOCIAL_NETWORKS - 1;
+
+    int queued = 0, rejected = 0;
+    for (int k = begin; k < end; k++) {
+        const JobPosting* p = share_all ? &g_job_postings[g_deadline_index[k]] : single;
+        for (int n = first_net; n <= last_net; n++) {
+            if (outbound_enqueue(n, p)) queued++;
+            else rejected++;
+        }
+    }
+    printf("\nQueued %d post(s) for delivery.\n", queued);
+    if (rejected > 0) printf("%d post(s) were not queued because the queue is full. Try again shortly.\n", rejected);
+}
+
+
+// --- Search Index ---
+
+static unsigned int hash_term(const char* term) {
+    unsigned int h = 2166136261u; // FNV-1a
+    while (*term) {
+        h ^= (unsigned char)*term++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Copies the next lowercase alphanumeric token of `*text` into `term`.
+ * @return 1 if a token was found (and `*text` advanced past it), 0 at end of text.
+ */
+static int next_term(const char** text, char* term) {
+    const char* p = *text;
+    while (*p && !isalnum((unsigned char)*p)) p++;
+    if (*p == '\0') {
+        *text = p;
+        return 0;
+    }
+    int len = 0;
+    while (isalnum((unsigned char)*p)) {
+        if (len < MAX_TERM_LENGTH - 1) term[len++] = (char)tolower((unsigned char)*p);
+        p++;
+    }
+    term[len] = '\0';
+    *text = p;
+    return 1;
+}
+
+/**
+ * @brief Returns the bucket holding `term`, or the empty bucket where it would be inserted.
+ */
+static TermEntry* term_bucket(const char* term) {
+    unsigned int mask = (unsigned int)g_term_table_capacity - 1;
+    unsigned int i = hash_term(term) & mask;
+    while (g_term_table[i].term != NULL && strcmp(g_term_table[i].term, term) != 0) {
+        i = (i + 1) & mask;
+    }
+    return &g_term_table[i];
+}
+
+static const TermEntry* find_term(const char* term) {
+    if (g_term_table == NULL) return NULL;
+    const TermEntry* entry = term_bucket(term);
+    return entry->term ? entry : NULL;
+}
+
+/**
+ * @brief Doubles the term table (or creates it) and rehashes every entry.
+ */
+static int grow_term_table() {
+    int old_capacity = g_term_table_capacity;
+    TermEntry* old_table = g_term_table;
+    int new_capacity = old_capacity ? old_capacity * 2 : TERM_TABLE_INITIAL_CAPACITY;
+    TermEntry* new_table = (TermEntry*)calloc(new_capacity, sizeof(TermEntry));
+    if (!new_table) return 0;
+    g_term_table = new_table;
+    g_term_table_capacity = new_capacity;
+    for (int i = 0; i < old_capacity; i++) {
+        if (old_table[i].term) *term_bucket(old_table[i].term) = old_table[i];
+    }
+    free(old_table);
+    return 1;
+}
+
+/**
+ * @brief Appends `id` to the posting list of `term`, creating the term if needed.
+ */
+static void add_term_occurrence(const char* term, int id) {
+    // Keep the load factor under 70% so probe sequences stay short
+    if ((g_term_count + 1) * 10 > g_term_table_capacity * 7 && !grow_term_table()) {
+        perror("Failed to grow the search index");
+        return;
+    }
+    TermEntry* entry = term_bucket(term);
+    if (entry->term == NULL) {
+        entry->term = strdup(term);
+        if (!entry->term) {
+            perror("Failed to add a search term");
+            return;
+        }
+        g_term_count++;
+    }
+    // A posting is indexed in one go, so a repeated term only ever repeats the last ID
+    if (entry->count > 0 && entry->ids[entry->count - 1] == id) return;
+    if (entry->count == entry->capacity) {
+        int new_capacity = entry->capacity ? entry->capacity * 2 : 4;
+        int* new_ids = (int*)realloc(entry->ids, new_capacity * sizeof(int));
+        if (!new_ids) {
+            perror("Failed to grow a search posting list");
+            return;
+        }
+        entry->ids = new_ids;
+        entry->capacity = new_capacity;
+    }
+    entry->ids[entry->count++] = id;
+}
+
+static void index_text(const char* text, int id) {
+    char term[MAX_TERM_LENGTH];
+    while (next_term(&text, term)) add_term_occurrence(term, id);
+}
+
+/**
+ * @brief Adds a posting's job field and qualifications to the search index.
+ */
+void index_posting(const JobPosting* posting) {
+    index_text(posting->job_field, posting->id);
+    for (int q = 0; q < posting->qualifications_count; q++) {
+        index_text(posting_qualification(posting, q), posting->id);
+    }
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_hits(const void* a, const void* b) {
+    const SearchHit* x = (const SearchHit*)a;
+    const SearchHit* y = (const SearchHit*)b;
+    if (x->matches != y->matches) return y->matches - x->matches; // More matched terms first
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+/**
+ * @brief Runs a query against the inverted index.
+ * @param query     Free text; each distinct alphanumeric word is one term.
+ * @param match_all 1 for AND (every term must match), 0 for OR (any term).
+ * @param hits      Receives a malloc'd array ranked by match count; caller frees.
+ * @return The number of hits, or -1 on allocation failure.
+ */
+int run_search_query(const char* query, int match_all, SearchHit** hits) {
+    char terms[MAX_QUERY_TERMS][MAX_TERM_LENGTH];
+    const TermEntry* lists[MAX_QUERY_TERMS];
+    int term_count = 0;
+    size_t total = 0;
+    char term[MAX_TERM_LENGTH];
+
+    *hits = NULL;
+    while (term_count < MAX_QUERY_TERMS && next_term(&query, term)) {
+        int duplicate = 0;
+        for (int t = 0; t < term_count && !duplicate; t++) duplicate = strcmp(terms[t], term) == 0;
+        if (duplicate) continue;
+        strcpy(terms[term_count], term);
+        lists[term_count] = find_term(term);
+        if (lists[term_count]) total += (size_t)lists[term_count]->count;
+        else if (match_all) return 0; // An unknown term can never be matched
+        term_count++;
+    }
+    if (total == 0) return 0;
+
+    // Merge the posting lists; after sorting, the run length of an ID is its match count.
+    int* all_ids = (int*)malloc(total * sizeof(int));
+    SearchHit* results = (SearchHit*)malloc(total * sizeof(SearchHit));
+    if (!all_ids || !results) {
+        free(all_ids);
+        free(results);
+        return -1;
+    }
+    size_t n = 0;
+    for (int t = 0; t < term_count; t++) {
+        if (!lists[t]) continue;
+        memcpy(all_ids + n, lists[t]->ids, (size_t)lists[t]->count * sizeof(int));
+        n += (size_t)lists[t]->count;
+    }
+    qsort(all_ids, n, sizeof(int), compare_ints);
+
+    int hit_count = 0;
+    for (size_t i = 0; i < n; ) {
+        size_t run = i;
+        while (run < n && all_ids[run] == all_ids[i]) run++;
+        int matches = (int)(run - i);
+        if (!match_all || matches == term_count) {
+            results[hit_count].id = all_ids[i];
+            results[hit_count].matches = matches;
+            hit_count++;
+        }
+        i = run;
+    }
+    free(all_ids);
+    if (hit_count == 0) {
+        free(results);
+        return 0;
+    }
+    qsort(results, hit_count, sizeof(SearchHit), compare_hits);
+    *hits = results;
+    return hit_count;
+}
+
+/**
+ * @brief Handles the user input for searching postings by field and qualifications.
+ */
+void search_postings() {
+    char query[1024];
+    char buffer[10];
+
+    printf("\n--- Search Postings ---\n");
+    printf("Search terms (field or qualification keywords): ");
+    fgets(query, sizeof(query), stdin);
+    query[strcspn(query, "\n")] = 0;
+    printf("Match 1. ALL terms  2. ANY term\nChoice: ");
+    fgets(buffer, sizeof(buffer), stdin);
+    int match_all = buffer[0] != '2';
+
+    SearchHit* hits;
+    int hit_count = run_search_query(query, match_all, &hits);
+    if (hit_count < 0) {
+        perror("Failed to run search");
+        return;
+    }
+    if (hit_count == 0) {
+        printf("No postings match '%s'.\n", query);
+        return;
+    }
+
+    printf("\n%-5s | %-7s | %-30s | %-20s | %-12s\n", "ID", "Matches", "Title", "Field", "Deadline");
+    printf("------------------------------------------------------------------------------------\n");
+    int shown = hit_count < SEARCH_RESULT_LIMIT ? hit_count : SEARCH_RESULT_LIMIT;
+    for (int i = 0; i < shown; i++) {
+        const JobPosting* p = find_posting_by_id(hits[i].id);
+        if (p == NULL) continue;
+        printf("%-5d | %-7d | %-30.30s | %-20.20s | %-12s\n", p->id, hits[i].matches, p->title, p->job_field, p->deadline);
+    }
+    if (hit_count > shown) printf("... and %d more posting(s).\n", hit_count - shown);
+    free(hits);
+}
+
+/**
+ * @brief Frees the search index.
+ */
+void free_search_index() {
+    for (int i = 0; i < g_term_table_capacity; i++) {
+        free(g_term_table[i].term);
+        free(g_term_table[i].ids);
     }
+    free(g_term_table);
+    g_term_table = NULL;
+    g_term_table_capacity = 0;
+    g_term_count = 0;
 }
 
 
 // --- File I/O for Persistence ---
+
+/**
+ * @brief Writes a string (including its terminator) to the blob section and advances the offset.
+ */
+static int write_blob_string(FILE* file, const char* str, uint32_t* offset) {
+    size_t len = strlen(str) + 1;
+    *offset += (uint32_t)len;
+    return fwrite(str, 1, len, file) == len;
+}
+
+/**
+ * @brief Saves all postings to FILENAME. The file is written to a temporary
+ *        path and renamed into place so a failed save never corrupts the old data.
+ */
 void save_postings() {
-    printf("\n--- Simulation: Saving Data ---\n");
-    printf("In a local environment, the %d job posting(s) would now be saved to '%s'.\n", g_post_count, FILENAME);
-    printf("-------------------------------\n");
+    FILE* file = fopen(FILENAME_TMP, "wb");
+    if (!file) {
+        perror("Failed to open postings file for writing");
+        return;
+    }
+    setvbuf(file, NULL, _IOFBF, SAVE_BUFFER_SIZE);
+
+    PostingFileHeader header;
+    memcpy(header.magic, POSTING_FILE_MAGIC, sizeof(header.magic));
+    header.version = POSTING_FILE_VERSION;
+    header.record_count = (uint32_t)g_post_count;
+    header.qual_count = 0;
+    header.blob_size = 0;
+    header.next_id = g_next_id;
+    for (int i = 0; i < g_post_count; i++) {
+        const JobPosting* p = &g_job_postings[i];
+        header.qual_count += (uint32_t)p->qualifications_count;
+        header.blob_size += (uint32_t)(strlen(p->title) + strlen(p->job_field) + 2);
+        for (int q = 0; q < p->qualifications_count; q++) {
+            header.blob_size += (uint32_t)(strlen(posting_qualification(p, q)) + 1);
+        }
+    }
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // Records: string offsets follow the same order the blob is written in below.
+    uint32_t blob_off = 0;
+    uint32_t qual_index = 0;
+    for (int i = 0; ok && i < g_post_count; i++) {
+        const JobPosting* p = &g_job_postings[i];
+        PostingFileRecord rec;
+        memset(&rec, 0, sizeof(rec));
+        rec.id = p->id;
+        rec.num_to_hire = p->num_to_hire;
+        memcpy(rec.posting_date, p->posting_date, sizeof(rec.posting_date));
+        memcpy(rec.deadline, p->deadline, sizeof(rec.deadline));
+        rec.posting_date[sizeof(rec.posting_date) - 1] = '\0';
+        rec.deadline[sizeof(rec.deadline) - 1] = '\0';
+        rec.title_off = blob_off;
+        blob_off += (uint32_t)strlen(p->title) + 1;
+        rec.field_off = blob_off;
+        blob_off += (uint32_t)strlen(p->job_field) + 1;
+        for (int q = 0; q < p->qualifications_count; q++) {
+            blob_off += (uint32_t)strlen(posting_qualification(p, q)) + 1;
+        }
+        rec.qual_first = qual_index;
+        rec.qual_count = (uint32_t)p->qualifications_count;
+        qual_index += rec.qual_count;
+        ok = fwrite(&rec, sizeof(rec), 1, file) == 1;
+    }
+
+    // Qualification offset table
+    blob_off = 0;
+    for (int i = 0; ok && i < g_post_count; i++) {
+        const JobPosting* p = &g_job_postings[i];
+        blob_off += (uint32_t)(strlen(p->title) + strlen(p->job_field) + 2);
+        for (int q = 0; ok && q < p->qualifications_count; q++) {
+            ok = fwrite(&blob_off, sizeof(blob_off), 1, file) == 1;
+            blob_off += (uint32_t)strlen(posting_qualification(p, q)) + 1;
+        }
+    }
+
+    // String blob
+    blob_off = 0;
+    for (int i = 0; ok && i < g_post_count; i++) {
+        const JobPosting* p = &g_job_postings[i];
+        ok = write_blob_string(file, p->title, &blob_off) && write_blob_string(file, p->job_field, &blob_off);
+        for (int q = 0; ok && q < p->qualifications_count; q++) {
+            ok = write_blob_string(file, posting_qualification(p, q), &blob_off);
+        }
+    }
+
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        perror("Failed to write postings file");
+        remove(FILENAME_TMP);
+        return;
+    }
+#ifdef _WIN32
+    remove(FILENAME); // rename() does not replace an existing file on Windows
+#endif
+    if (rename(FILENAME_TMP, FILENAME) != 0) {
+        perror("Failed to replace postings file");
+        remove(FILENAME_TMP);
+        return;
+    }
+    printf("\n--- Saved %d job posting(s) to '%s' ---\n", g_post_count, FILENAME);
+}
+
+/**
+ * @brief Maps (or reads) the whole postings file into g_db_image.
+ * @return 1 on success, 0 if the file is missing or unreadable.
+ */
+static int read_db_image() {
+#ifndef _WIN32
+    int fd = open(FILENAME, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+    g_db_image = (char*)map;
+    g_db_image_size = (size_t)st.st_size;
+    return 1;
+#else
+    FILE* file = fopen(FILENAME, "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0 || (g_db_image = (char*)malloc((size_t)size)) == NULL) {
+        fclose(file);
+        return 0;
+    }
+    g_db_image_size = fread(g_db_image, 1, (size_t)size, file);
+    fclose(file);
+    return g_db_image_size == (size_t)size;
+#endif
+}
+
+static void release_db_image() {
+    if (g_db_image == NULL) return;
+#ifndef _WIN32
+    munmap(g_db_image, g_db_image_size);
+#else
+    free(g_db_image);
+#endif
+    g_db_image = NULL;
+    g_db_image_size = 0;
+}
+
+/**
+ * @brief Frees every table a partially completed load_postings() may have set up.
+ */
+static void discard_loaded_postings() {
+    free(g_job_postings);
+    free(g_deadline_index);
+    free(g_id_slots);
+    g_job_postings = NULL;
+    g_deadline_index = NULL;
+    g_id_slots = NULL;
+    g_id_slots_capacity = 0;
+    arena_truncate(0);
+    release_db_image();
 }
 
+/**
+ * @brief Loads FILENAME into a pre-sized posting array. The qualification offset
+ *        table and string blob are copied into the arena as two blocks.
+ */
 void load_postings() {
-    FILE* file = fopen(FILENAME, "r");
-    if(!file) {
+    if (!read_db_image()) {
+        release_db_image();
         printf("Notice: '%s' not found. Starting with an empty database.\n", FILENAME);
         return;
     }
-    // File loading logic would go here if this were not an online compiler
-    fclose(file);
+
+    const PostingFileHeader* header = (const PostingFileHeader*)g_db_image;
+    size_t records_size = 0, offsets_size = 0;
+    int valid = g_db_image_size >= sizeof(*header)
+        && memcmp(header->magic, POSTING_FILE_MAGIC, sizeof(header->magic)) == 0
+        && header->version == POSTING_FILE_VERSION;
+    if (valid) {
+        records_size = (size_t)header->record_count * sizeof(PostingFileRecord);
+        offsets_size = (size_t)header->qual_count * sizeof(uint32_t);
+        valid = g_db_image_size == sizeof(*header) + records_size + offsets_size + header->blob_size
+            && (header->record_count == 0 || header->blob_size > 0);
+    }
+    const PostingFileRecord* records = (const PostingFileRecord*)(g_db_image + sizeof(*header));
+    const uint32_t* offsets = (const uint32_t*)(g_db_image + sizeof(*header) + records_size);
+    char* blob = g_db_image + sizeof(*header) + records_size + offsets_size;
+    if (valid && header->blob_size > 0) {
+        // A trailing terminator guarantees every in-range offset names a terminated string.
+        valid = blob[header->blob_size - 1] == '\0';
+    }
+    for (uint32_t q = 0; valid && q < header->qual_count; q++) {
+        valid = offsets[q] < header->blob_size;
+    }
+    for (uint32_t i = 0; valid && i < header->record_count; i++) {
+        valid = records[i].title_off < header->blob_size
+            && records[i].field_off < header->blob_size
+            && records[i].qual_first <= header->qual_count
+            && records[i].qual_count <= header->qual_count - records[i].qual_first;
+    }
+    if (!valid) {
+        printf("Warning: '%s' is corrupt or from an unsupported version. Starting with an empty database.\n", FILENAME);
+        release_db_image();
+        return;
+    }
+
+    int count = (int)header->record_count;
+    int capacity = count > INITIAL_CAPACITY ? count : INITIAL_CAPACITY;
+    g_job_postings = (JobPosting*)malloc(capacity * sizeof(JobPosting));
+    g_deadline_index = (int*)malloc(capacity * sizeof(int));
+    arena_truncate(0);
+    if (!g_job_postings || !g_deadline_index || !arena_reserve(header->blob_size, (int)header->qual_count)) {
+        perror("Failed to allocate memory for job postings");
+        discard_loaded_postings();
+        return;
+    }
+    // Every saved ID is below the saved next_id. The id table is dense, so an ID far
+    // beyond the record count would allocate a huge, almost empty table.
+    int64_t id_limit = (int64_t)count * MAX_ID_SLOTS_PER_POSTING + INITIAL_CAPACITY;
+    for (int i = 0; i < count; i++) {
+        int id = records[i].id;
+        // Duplicate or non-positive IDs would make lookups ambiguous
+        if (id <= 0 || id >= header->next_id || id > id_limit
+            || find_posting_by_id(id) != NULL || !id_slots_set(id, i)) {
+            printf("Warning: could not index posting IDs in '%s'. Starting with an empty database.\n", FILENAME);
+            discard_loaded_postings();
+            return;
+        }
+    }
+    // Title and field strings are copied along with the blob; they are a small
+    // fraction of it and keeping the block intact avoids rewriting every offset.
+    memcpy(g_string_arena, blob, header->blob_size);
+    memcpy(g_qual_offsets, offsets, offsets_size);
+    g_arena_size = header->blob_size;
+    g_qual_count = (int)header->qual_count;
+
+    int next_id = header->next_id > 0 ? header->next_id : 1;
+    for (int i = 0; i < count; i++) {
+        const PostingFileRecord* rec = &records[i];
+        JobPosting* p = &g_job_postings[i];
+        p->id = rec->id;
+        p->num_to_hire = rec->num_to_hire;
+        memcpy(p->posting_date, rec->posting_date, sizeof(p->posting_date));
+        memcpy(p->deadline, rec->deadline, sizeof(p->deadline));
+        p->posting_date[sizeof(p->posting_date) - 1] = '\0';
+        p->deadline[sizeof(p->deadline) - 1] = '\0';
+        snprintf(p->title, sizeof(p->title), "%s", blob + rec->title_off);
+        snprintf(p->job_field, sizeof(p->job_field), "%s", blob + rec->field_off);
+        p->qual_first = (int)rec->qual_first;
+        p->qualifications_count = (int)rec->qual_count;
+        p->deadline_day = date_to_day_number(p->deadline);
+        if (p->id >= next_id) next_id = p->id + 1;
+    }
+
+    g_post_count = count;
+    g_post_capacity = capacity;
+    g_next_id = next_id;
+    deadline_index_rebuild();
+    for (int i = 0; i < count; i++) index_posting(&g_job_postings[i]);
+    release_db_image();
+    printf("Loaded %d job posting(s) from '%s'.\n", count, FILENAME);
 }
 
 
@@ -343,6 +1311,7 @@ void findSpecialist() {
         printf("   1. Create Job Posting\n");
         printf("   2. View Job Postings\n");
         printf("   3. Post on Social Networks\n");
+        printf("   4. Search Postings\n");
         printf("   0. Exit and Save\n");
         printf("----------------------------------------\n");
         printf("Choice: ");
@@ -363,6 +1332,7 @@ void findSpecialist() {
                 break;
             }
             case '3': post_to_social_media(); break;
+            case '4': search_postings(); break;
             default: printf("Invalid choice.\n");
         }
         printf("\nPress Enter to continue...");
@@ -373,16 +1343,13 @@ void findSpecialist() {
 
 // --- Cleanup ---
 void cleanup_stage6_data() {
-    if (g_job_postings != NULL) {
-        for (int i = 0; i < g_post_count; i++) {
-            // Free the dynamically allocated strings inside the qualifications array
-            for (int q = 0; q < g_job_postings[i].qualifications_count; q++) {
-                free(g_job_postings[i].qualifications[q]);
-            }
-            // Free the qualifications array itself
-            free(g_job_postings[i].qualifications);
-        }
-        // Free the main array of job postings
-        free(g_job_postings);
-    }
+    // Deliver anything still queued before the program exits
+    outbound_shutdown();
+    // Qualification strings live in the arena, so no per-posting frees are needed
+    free(g_job_postings);
+    free(g_string_arena);
+    free(g_qual_offsets);
+    free(g_deadline_index);
+    free(g_id_slots);
+    free_search_index();
 }
@@ -5,8 +5,19 @@
  * This program combines all necessary functions into a single file. It features
  * a game where users match K-POP groups to their correct concepts. The user can
  * choose to play the game using either a Stack or a Queue data structure, fulfilling
- * the bonus requirement. It includes a fallback mechanism to use hardcoded data
- * if the required input file is not found.
+ * the bonus requirement. Both structures come in three storage flavours behind
+ * one API: plain malloc'd linked nodes, linked nodes drawn from a slab pool, and a
+ * contiguous array (a ring buffer for the queue). The concept database grows to
+ * any size: group and concept names are interned, and a hash from group name to
+ * concept makes checking an answer O(1). It includes a fallback mechanism to use
+ * hardcoded data if the required input file is not found.
+ *
+ * Headless mode: `program --score <sessions file>` scores a file of recorded
+ * games on all cores and prints accuracy per group and per concept. Each line is
+ * one session: "group|group|...;concept|concept|...;match match ...", where the
+ * concepts are in the order shown to the player and each match is the 1-based
+ * concept number chosen for the group at the same position. Blank lines and lines
+ * starting with '#' are ignored.
  */
 
 #include <stdio.h>
@@ -14,38 +25,127 @@
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 // --- Constants and Data Structures ---
-#define MAX_CONCEPTS 20
+#define CONCEPT_FILENAME "concept.txt"
+#define CONCEPT_INITIAL_CAPACITY 64
+#define TEXT_POOL_INITIAL_CAPACITY 4096
+#define NAME_TABLE_INITIAL_CAPACITY 256 // Hash slots; always a power of two
+#define NO_CONCEPT UINT32_MAX
+#define MAX_SCORING_THREADS 16
+#define MIN_BYTES_PER_THREAD (64 * 1024) // Smaller session files are not worth splitting
+#define MAX_SESSION_ITEMS 64
+#define NODE_DATA_SIZE 100
+#define NODES_PER_SLAB 256
+#define ARRAY_INITIAL_CAPACITY 8
+#define BENCH_ITEMS 16         // Elements per build/tear-down cycle (a game uses at most 4)
+#define BENCH_ROUNDS 200000
 
-// Structure to hold one concept entry from the database
+// Structure to hold one concept entry from the database. Names are interned IDs
+// (see internedName()); the description is an offset into g_text_pool.
 typedef struct {
-    char group_name[100];
-    char concept_name[100];
-    char description[512];
+    uint32_t group_name;
+    uint32_t concept_name;
+    uint32_t description;
 } ConceptData;
 
+// Every string in the concept database, NUL-terminated and addressed by offset
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} TextPool;
+
+// Interned names: ID -> text offset, plus an open-addressing hash from text to ID.
+// `concept_of` maps a group name's ID to its row in g_concept_db, which makes the
+// table double as the group -> concept lookup.
+typedef struct {
+    uint32_t* text_off;     // Indexed by name ID
+    uint32_t* concept_of;   // Indexed by name ID; NO_CONCEPT unless it names a group
+    int count;
+    int capacity;
+    int32_t* slots;         // Name ID, or -1 for an empty slot
+    int slot_capacity;
+} NameTable;
+
 // Node for the Linked List (used by both Stack and Queue)
 typedef struct Node {
-    char data[100];
+    char data[NODE_DATA_SIZE];
     struct Node* next;
 } Node;
 
+// How a Stack or Queue stores its elements
+typedef enum {
+    STORAGE_LINKED,     // One malloc/free per node
+    STORAGE_POOLED,     // Linked nodes recycled through g_node_pool
+    STORAGE_ARRAY       // One contiguous, doubling array of elements
+} StorageKind;
+
 // Stack structure
 typedef struct {
-    Node* top;
+    StorageKind kind;
+    Node* top;                      // Linked storage
+    char (*items)[NODE_DATA_SIZE];  // Array storage; items[count - 1] is the top
+    int count;
+    int capacity;
 } Stack;
 
 // Queue structure
 typedef struct {
-    Node* front;
+    StorageKind kind;
+    Node* front;                    // Linked storage
     Node* rear;
+    char (*items)[NODE_DATA_SIZE];  // Array storage, used as a ring starting at `head`
+    int head;
+    int count;
+    int capacity;
 } Queue;
 
+// Slabs of nodes handed out through a freelist. Freed nodes go back on the list,
+// and slabs are only released at exit.
+typedef struct NodeSlab {
+    struct NodeSlab* next;
+    Node nodes[NODES_PER_SLAB];
+} NodeSlab;
+
+typedef struct {
+    NodeSlab* slabs;
+    Node* free_list;
+} NodePool;
+
+
+// Attempts and correct answers for one group or concept
+typedef struct {
+    uint32_t attempts;
+    uint32_t correct;
+} MatchTally;
+
+// One worker's share of a batch: the session lines in [begin, end), tallied into
+// private arrays that are summed once every worker has finished.
+typedef struct {
+    const char* begin;
+    const char* end;
+    MatchTally* by_group;   // Indexed by concept row
+    MatchTally* by_concept; // Indexed by concept name ID
+    long sessions;
+    long malformed;
+    long unknown_items;     // Items naming a group that is not in the database
+} ScoringTask;
+
 
 // --- Global Data Storage ---
 ConceptData* g_concept_db = NULL;
 int g_concept_count = 0;
+int g_concept_capacity = 0;
+TextPool g_text_pool = {NULL, 0, 0};
+NameTable g_names = {NULL, NULL, 0, 0, NULL, 0};
+NodePool g_node_pool = {NULL, NULL};
+StorageKind g_game_storage = STORAGE_POOLED; // Storage used by the matching game
 
 
 // --- Forward Declarations for All Functions ---
@@ -55,12 +155,21 @@ void show_main_menu();
 void show_training_menu();
 void show_visual_menu();
 void defineConcept();
+void benchmarkStackQueue();
+void load_concepts();
+int scoreSessionsFile(const char* path);
 
 
 // --- Main Entry Point ---
-int main() {
+int main(int argc, char** argv) {
     // Register the cleanup function to be called on normal program termination
     atexit(cleanup_stage6_data);
+
+    if (argc >= 3 && strcmp(argv[1], "--score") == 0) {
+        load_concepts();
+        if (g_concept_count == 0) { printf("Failed to load concept data.\n"); return 1; }
+        return scoreSessionsFile(argv[2]) ? 0 : 1;
+    }
     
     // Seed the random number generator once at the start
     srand(time(NULL));
@@ -94,6 +203,7 @@ void show_visual_menu() {
         printf("----------------------------------------\n");
         printf("   A. Finding People\n");
         printf("   B. Concept Research\n");
+        printf("   C. Stack/Queue Storage Benchmark\n");
         printf("   0. Back\n");
         printf("----------------------------------------\n");
         printf("Select an option: ");
@@ -105,6 +215,10 @@ void show_visual_menu() {
              getchar();
         } else if (toupper(choice) == 'B') {
             defineConcept();
+        } else if (toupper(choice) == 'C') {
+            benchmarkStackQueue();
+            printf("\nPress Enter to continue...");
+            getchar();
         }
     } while(choice != '0');
 }
@@ -151,80 +265,452 @@ void show_main_menu() {
 
 // --- Feature Logic Functions ---
 
-// Linked List Stack & Queue Operations
-Stack* createStack() { Stack* s = (Stack*)malloc(sizeof(Stack)); s->top = NULL; return s; }
-Queue* createQueue() { Queue* q = (Queue*)malloc(sizeof(Queue)); q->front = q->rear = NULL; return q; }
+// --- Node Pool ---
+static Node* poolAlloc() {
+    if (g_node_pool.free_list == NULL) {
+        NodeSlab* slab = (NodeSlab*)malloc(sizeof(NodeSlab));
+        if (!slab) return NULL;
+        slab->next = g_node_pool.slabs;
+        g_node_pool.slabs = slab;
+        for (int i = NODES_PER_SLAB - 1; i >= 0; i--) {
+            slab->nodes[i].next = g_node_pool.free_list;
+            g_node_pool.free_list = &slab->nodes[i];
+        }
+    }
+    Node* node = g_node_pool.free_list;
+    g_node_pool.free_list = node->next;
+    return node;
+}
+
+/**
+ * @brief Returns a whole chain of pooled nodes (ending at `last`) to the freelist.
+ */
+static void poolReleaseChain(Node* first, Node* last) {
+    if (first == NULL) return;
+    last->next = g_node_pool.free_list;
+    g_node_pool.free_list = first;
+}
+
+static void destroyNodePool() {
+    while (g_node_pool.slabs != NULL) {
+        NodeSlab* next = g_node_pool.slabs->next;
+        free(g_node_pool.slabs);
+        g_node_pool.slabs = next;
+    }
+    g_node_pool.free_list = NULL;
+}
+
+// --- Stack & Queue Operations ---
+static Node* allocNode(StorageKind kind) {
+    return kind == STORAGE_POOLED ? poolAlloc() : (Node*)malloc(sizeof(Node));
+}
+
+static void freeNodeChain(StorageKind kind, Node* first) {
+    if (kind == STORAGE_POOLED) {
+        Node* last = first;
+        while (last != NULL && last->next != NULL) last = last->next;
+        poolReleaseChain(first, last);
+        return;
+    }
+    while(first != NULL) { Node* temp = first; first = first->next; free(temp); }
+}
+
+static void copyItem(char* dest, const char* src) {
+    size_t len = strlen(src);
+    if (len >= NODE_DATA_SIZE) len = NODE_DATA_SIZE - 1;
+    memcpy(dest, src, len);
+    dest[len] = '\0';
+}
 
-void push(Stack* s, const char* data) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    strcpy(newNode->data, data);
+/**
+ * @brief Makes room for one more element in an array-backed stack or queue.
+ *        A queue's ring is unrolled so it starts at index 0 again.
+ */
+static int growItems(char (**items)[NODE_DATA_SIZE], int* capacity, int head, int count) {
+    if (count < *capacity) return 1;
+    int new_capacity = *capacity ? *capacity * 2 : ARRAY_INITIAL_CAPACITY;
+    char (*new_items)[NODE_DATA_SIZE] = malloc((size_t)new_capacity * NODE_DATA_SIZE);
+    if (!new_items) return 0;
+    int first_run = *capacity - head < count ? *capacity - head : count;
+    if (count > 0) {
+        memcpy(new_items, *items + head, (size_t)first_run * NODE_DATA_SIZE);
+        memcpy(new_items + first_run, *items, (size_t)(count - first_run) * NODE_DATA_SIZE);
+    }
+    free(*items);
+    *items = new_items;
+    *capacity = new_capacity;
+    return 1;
+}
+
+Stack* createStackWith(StorageKind kind) {
+    Stack* s = (Stack*)calloc(1, sizeof(Stack));
+    if (s) s->kind = kind;
+    return s;
+}
+Queue* createQueueWith(StorageKind kind) {
+    Queue* q = (Queue*)calloc(1, sizeof(Queue));
+    if (q) q->kind = kind;
+    return q;
+}
+Stack* createStack() { return createStackWith(g_game_storage); }
+Queue* createQueue() { return createQueueWith(g_game_storage); }
+
+/**
+ * @return 1 on success, 0 if memory ran out.
+ */
+int push(Stack* s, const char* data) {
+    if (s->kind == STORAGE_ARRAY) {
+        if (!growItems(&s->items, &s->capacity, 0, s->count)) return 0;
+        copyItem(s->items[s->count++], data);
+        return 1;
+    }
+    Node* newNode = allocNode(s->kind);
+    if (!newNode) return 0;
+    copyItem(newNode->data, data);
     newNode->next = s->top;
     s->top = newNode;
+    s->count++;
+    return 1;
 }
 
-void enqueue(Queue* q, const char* data) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    strcpy(newNode->data, data);
+/**
+ * @return 1 on success, 0 if memory ran out.
+ */
+int enqueue(Queue* q, const char* data) {
+    if (q->kind == STORAGE_ARRAY) {
+        if (q->count == q->capacity) {
+            if (!growItems(&q->items, &q->capacity, q->head, q->count)) return 0;
+            q->head = 0;
+        }
+        copyItem(q->items[(q->head + q->count) % q->capacity], data);
+        q->count++;
+        return 1;
+    }
+    Node* newNode = allocNode(q->kind);
+    if (!newNode) return 0;
+    copyItem(newNode->data, data);
     newNode->next = NULL;
     if(q->rear == NULL) q->front = q->rear = newNode;
     else { q->rear->next = newNode; q->rear = newNode; }
+    q->count++;
+    return 1;
+}
+
+/**
+ * @brief Removes the top element, copying it into `out` (at least NODE_DATA_SIZE bytes) if given.
+ * @return 1 if an element was removed, 0 if the stack was empty.
+ */
+int pop(Stack* s, char* out) {
+    if (s->count == 0) return 0;
+    s->count--;
+    if (s->kind == STORAGE_ARRAY) {
+        if (out) strcpy(out, s->items[s->count]);
+        return 1;
+    }
+    Node* node = s->top;
+    s->top = node->next;
+    if (out) strcpy(out, node->data);
+    if (s->kind == STORAGE_POOLED) poolReleaseChain(node, node);
+    else free(node);
+    return 1;
+}
+
+/**
+ * @brief Removes the front element, copying it into `out` (at least NODE_DATA_SIZE bytes) if given.
+ * @return 1 if an element was removed, 0 if the queue was empty.
+ */
+int dequeue(Queue* q, char* out) {
+    if (q->count == 0) return 0;
+    q->count--;
+    if (q->kind == STORAGE_ARRAY) {
+        if (out) strcpy(out, q->items[q->head]);
+        q->head = (q->head + 1) % q->capacity;
+        return 1;
+    }
+    Node* node = q->front;
+    q->front = node->next;
+    if (q->front == NULL) q->rear = NULL;
+    if (out) strcpy(out, node->data);
+    if (q->kind == STORAGE_POOLED) poolReleaseChain(node, node);
+    else free(node);
+    return 1;
 }
 
 void destroyStack(Stack* s) {
-    Node* current = s->top;
-    while(current != NULL) { Node* temp = current; current = current->next; free(temp); }
+    if (s == NULL) return;
+    freeNodeChain(s->kind, s->top);
+    free(s->items);
     free(s);
 }
 void destroyQueue(Queue* q) {
-    Node* current = q->front;
-    while(current != NULL) { Node* temp = current; current = current->next; free(temp); }
+    if (q == NULL) return;
+    if (q->kind == STORAGE_POOLED) poolReleaseChain(q->front, q->rear); // The rear is known: O(1)
+    else freeNodeChain(q->kind, q->front);
+    free(q->items);
     free(q);
 }
 
+static double secondsSince(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Times the build/drain/tear-down cycle the game performs, for each storage kind.
+ */
+void benchmarkStackQueue() {
+    const char* names[] = {"Linked (malloc)", "Pooled nodes", "Array / ring"};
+    const char* item = "Social Commentary";
+    char out[NODE_DATA_SIZE];
+
+    printf("\n--- Stack/Queue Benchmark (%d items x %d rounds) ---\n", BENCH_ITEMS, BENCH_ROUNDS);
+    printf("%-16s | %14s | %14s\n", "Storage", "stack ns/item", "queue ns/item");
+    printf("------------------------------------------------\n");
+    for (int kind = STORAGE_LINKED; kind <= STORAGE_ARRAY; kind++) {
+        double ns[2];
+        for (int pass = 0; pass < 2; pass++) {
+            struct timespec start;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int r = 0; r < BENCH_ROUNDS; r++) {
+                if (pass == 0) {
+                    Stack* s = createStackWith((StorageKind)kind);
+                    for (int i = 0; i < BENCH_ITEMS; i++) push(s, item);
+                    for (int i = 0; i < BENCH_ITEMS / 2; i++) pop(s, out);
+                    destroyStack(s);
+                } else {
+                    Queue* q = createQueueWith((StorageKind)kind);
+                    for (int i = 0; i < BENCH_ITEMS; i++) enqueue(q, item);
+                    for (int i = 0; i < BENCH_ITEMS / 2; i++) dequeue(q, out);
+                    destroyQueue(q);
+                }
+            }
+            ns[pass] = secondsSince(&start) * 1e9 / ((double)BENCH_ROUNDS * BENCH_ITEMS);
+        }
+        printf("%-16s | %14.1f | %14.1f\n", names[kind], ns[0], ns[1]);
+    }
+}
+
+// --- Concept Database ---
+static int poolAddText(const char* text, size_t len, uint32_t* off) {
+    if (g_text_pool.size + len + 1 > UINT32_MAX) return 0;
+    if (g_text_pool.size + len + 1 > g_text_pool.capacity) {
+        size_t new_capacity = g_text_pool.capacity ? g_text_pool.capacity : TEXT_POOL_INITIAL_CAPACITY;
+        while (new_capacity < g_text_pool.size + len + 1) new_capacity *= 2;
+        char* new_data = (char*)realloc(g_text_pool.data, new_capacity);
+        if (!new_data) return 0;
+        g_text_pool.data = new_data;
+        g_text_pool.capacity = new_capacity;
+    }
+    *off = (uint32_t)g_text_pool.size;
+    memcpy(g_text_pool.data + g_text_pool.size, text, len);
+    g_text_pool.data[g_text_pool.size + len] = '\0';
+    g_text_pool.size += len + 1;
+    return 1;
+}
+
+const char* internedName(uint32_t id) {
+    return g_text_pool.data + g_names.text_off[id];
+}
+
+const char* conceptDescription(const ConceptData* c) {
+    return g_text_pool.data + c->description;
+}
+
+static uint32_t hashName(const char* text, size_t len) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Finds the hash slot holding `text`, or the empty slot where it belongs.
+ */
+static int findNameSlot(const char* text, size_t len) {
+    int mask = g_names.slot_capacity - 1;
+    int slot = (int)(hashName(text, len) & (uint32_t)mask);
+    while (g_names.slots[slot] >= 0) {
+        const char* name = internedName((uint32_t)g_names.slots[slot]);
+        if (strncmp(name, text, len) == 0 && name[len] == '\0') break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static int growNameSlots() {
+    int new_capacity = g_names.slot_capacity ? g_names.slot_capacity * 2 : NAME_TABLE_INITIAL_CAPACITY;
+    int32_t* new_slots = (int32_t*)malloc((size_t)new_capacity * sizeof(int32_t));
+    if (!new_slots) return 0;
+    for (int i = 0; i < new_capacity; i++) new_slots[i] = -1;
+    free(g_names.slots);
+    g_names.slots = new_slots;
+    g_names.slot_capacity = new_capacity;
+    for (int id = 0; id < g_names.count; id++) {
+        const char* name = internedName((uint32_t)id);
+        g_names.slots[findNameSlot(name, strlen(name))] = id;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the ID of `text` (of length `len`), or NO_CONCEPT if it was never interned.
+ */
+uint32_t lookupName(const char* text, size_t len) {
+    if (g_names.slot_capacity == 0) return NO_CONCEPT;
+    int32_t id = g_names.slots[findNameSlot(text, len)];
+    return id >= 0 ? (uint32_t)id : NO_CONCEPT;
+}
+
+/**
+ * @brief Returns the ID of `text`, adding it to the table the first time it is seen.
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int internName(const char* text, size_t len, uint32_t* id) {
+    if (2 * (g_names.count + 1) > g_names.slot_capacity && !growNameSlots()) return 0;
+    int slot = findNameSlot(text, len);
+    if (g_names.slots[slot] >= 0) {
+        *id = (uint32_t)g_names.slots[slot];
+        return 1;
+    }
+    if (g_names.count == g_names.capacity) {
+        int new_capacity = g_names.capacity ? g_names.capacity * 2 : NAME_TABLE_INITIAL_CAPACITY;
+        uint32_t* new_off = (uint32_t*)realloc(g_names.text_off, (size_t)new_capacity * sizeof(uint32_t));
+        if (!new_off) return 0;
+        g_names.text_off = new_off;
+        uint32_t* new_concept = (uint32_t*)realloc(g_names.concept_of, (size_t)new_capacity * sizeof(uint32_t));
+        if (!new_concept) return 0;
+        g_names.concept_of = new_concept;
+        g_names.capacity = new_capacity;
+    }
+    uint32_t off;
+    if (!poolAddText(text, len, &off)) return 0;
+    *id = (uint32_t)g_names.count;
+    g_names.text_off[*id] = off;
+    g_names.concept_of[*id] = NO_CONCEPT;
+    g_names.slots[slot] = (int32_t)*id;
+    g_names.count++;
+    return 1;
+}
+
+/**
+ * @brief Returns the row in g_concept_db for a group name, or NO_CONCEPT.
+ */
+uint32_t conceptForGroup(const char* group, size_t len) {
+    uint32_t id = lookupName(group, len);
+    return id == NO_CONCEPT ? NO_CONCEPT : g_names.concept_of[id];
+}
+
+/**
+ * @brief Appends one entry. A group already in the database keeps its first concept.
+ * @return 1 if added, 0 if it was a duplicate group, -1 on allocation failure.
+ */
+static int addConcept(const char* group, size_t group_len, const char* concept, size_t concept_len,
+                      const char* desc, size_t desc_len) {
+    ConceptData entry;
+    if (!internName(group, group_len, &entry.group_name)) return -1;
+    if (g_names.concept_of[entry.group_name] != NO_CONCEPT) return 0;
+    if (!internName(concept, concept_len, &entry.concept_name)
+        || !poolAddText(desc, desc_len, &entry.description)) {
+        return -1;
+    }
+    if (g_concept_count == g_concept_capacity) {
+        int new_capacity = g_concept_capacity ? g_concept_capacity * 2 : CONCEPT_INITIAL_CAPACITY;
+        ConceptData* new_db = (ConceptData*)realloc(g_concept_db, (size_t)new_capacity * sizeof(ConceptData));
+        if (!new_db) return -1;
+        g_concept_db = new_db;
+        g_concept_capacity = new_capacity;
+    }
+    g_names.concept_of[entry.group_name] = (uint32_t)g_concept_count;
+    g_concept_db[g_concept_count++] = entry;
+    return 1;
+}
+
+/**
+ * @brief Parses "group;concept;description" lines from `text`. Lines missing a
+ *        field are skipped; the description is everything after the second ';'.
+ */
+static void parseConcepts(const char* text, size_t size) {
+    const char* end = text + size;
+    int duplicates = 0;
+    while (text < end) {
+        const char* nl = (const char*)memchr(text, '\n', (size_t)(end - text));
+        const char* line_end = nl ? nl : end;
+        const char* cr = (const char*)memchr(text, '\r', (size_t)(line_end - text));
+        if (cr) line_end = cr;
+        const char* sep1 = (const char*)memchr(text, ';', (size_t)(line_end - text));
+        const char* sep2 = sep1 ? (const char*)memchr(sep1 + 1, ';', (size_t)(line_end - sep1 - 1)) : NULL;
+        if (sep2 && sep1 > text && sep2 > sep1 + 1 && line_end > sep2 + 1) {
+            int added = addConcept(text, (size_t)(sep1 - text), sep1 + 1, (size_t)(sep2 - sep1 - 1),
+                                   sep2 + 1, (size_t)(line_end - sep2 - 1));
+            if (added < 0) {
+                perror("Failed to store concept data");
+                return;
+            }
+            if (added == 0) duplicates++;
+        }
+        text = nl ? nl + 1 : end;
+    }
+    if (duplicates > 0) printf("Notice: skipped %d duplicate group(s) in '" CONCEPT_FILENAME "'.\n", duplicates);
+}
+
 void load_concepts() {
     if (g_concept_db != NULL) return;
 
-    FILE* file = fopen("concept.txt", "r");
+    FILE* file = fopen(CONCEPT_FILENAME, "rb");
     if (!file) {
         // --- Fallback for Online Compilers ---
-        printf("Notice: 'concept.txt' not found. Using hardcoded fallback data.\n");
-        g_concept_db = (ConceptData*)malloc(7 * sizeof(ConceptData));
-        if(!g_concept_db) return;
-        g_concept_count = 7;
-        strcpy(g_concept_db[0].group_name, "Wonder Girls"); strcpy(g_concept_db[0].concept_name, "Retro"); strcpy(g_concept_db[0].description, "A concept that reinterprets past trends in a modern way.");
-        strcpy(g_concept_db[1].group_name, "2PM"); strcpy(g_concept_db[1].concept_name, "Beastly Idol"); strcpy(g_concept_db[1].description, "A concept emphasizing powerful and masculine performances.");
-        strcpy(g_concept_db[2].group_name, "Crayon Pop"); strcpy(g_concept_db[2].concept_name, "Goofy/Novelty"); strcpy(g_concept_db[2].description, "A unique concept using helmets and quirky choreography.");
-        strcpy(g_concept_db[3].group_name, "Girl's Day"); strcpy(g_concept_db[3].concept_name, "Sexy"); strcpy(g_concept_db[3].description, "A concept highlighting mature and alluring charms.");
-        strcpy(g_concept_db[4].group_name, "BTS"); strcpy(g_concept_db[4].concept_name, "Social Commentary"); strcpy(g_concept_db[4].description, "A concept that includes messages about social issues and youth struggles.");
-        strcpy(g_concept_db[5].group_name, "aespa"); strcpy(g_concept_db[5].concept_name, "Metaverse/AI"); strcpy(g_concept_db[5].description, "A futuristic concept involving virtual avatars and a digital world.");
-        strcpy(g_concept_db[6].group_name, "SHINee"); strcpy(g_concept_db[6].concept_name, "Contemporary"); strcpy(g_concept_db[6].description, "A trend-setting concept that always presents a sophisticated and modern style.");
+        printf("Notice: '" CONCEPT_FILENAME "' not found. Using hardcoded fallback data.\n");
+        static const char* fallback[][3] = {
+            {"Wonder Girls", "Retro", "A concept that reinterprets past trends in a modern way."},
+            {"2PM", "Beastly Idol", "A concept emphasizing powerful and masculine performances."},
+            {"Crayon Pop", "Goofy/Novelty", "A unique concept using helmets and quirky choreography."},
+            {"Girl's Day", "Sexy", "A concept highlighting mature and alluring charms."},
+            {"BTS", "Social Commentary", "A concept that includes messages about social issues and youth struggles."},
+            {"aespa", "Metaverse/AI", "A futuristic concept involving virtual avatars and a digital world."},
+            {"SHINee", "Contemporary", "A trend-setting concept that always presents a sophisticated and modern style."}
+        };
+        for (size_t i = 0; i < sizeof(fallback) / sizeof(fallback[0]); i++) {
+            if (addConcept(fallback[i][0], strlen(fallback[i][0]), fallback[i][1], strlen(fallback[i][1]),
+                           fallback[i][2], strlen(fallback[i][2])) < 0) {
+                perror("Failed to store concept data");
+                return;
+            }
+        }
         return;
     }
-    
-    g_concept_db = (ConceptData*)malloc(MAX_CONCEPTS * sizeof(ConceptData));
-    char line[1024];
-    while(g_concept_count < MAX_CONCEPTS && fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\r\n")] = 0;
-        char* group = strtok(line, ";");
-        char* concept = strtok(NULL, ";");
-        char* desc = strtok(NULL, "");
-        if(group && concept && desc) {
-            strcpy(g_concept_db[g_concept_count].group_name, group);
-            strcpy(g_concept_db[g_concept_count].concept_name, concept);
-            strcpy(g_concept_db[g_concept_count].description, desc);
-            g_concept_count++;
-        }
+
+    // One read of the whole file, then an in-memory parse
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = size > 0 ? (char*)malloc((size_t)size) : NULL;
+    if (text && fread(text, 1, (size_t)size, file) == (size_t)size) {
+        parseConcepts(text, (size_t)size);
+    } else if (size > 0) {
+        perror("Failed to read '" CONCEPT_FILENAME "'");
     }
+    free(text);
     fclose(file);
 }
 
-void playMatchingGame(char** groups, char** concepts, ConceptData* original_data, int count) {
+/**
+ * @brief Returns a uniformly distributed index below `n`, even where RAND_MAX is 32767.
+ */
+static int randomIndex(int n) {
+    unsigned long r = ((unsigned long)rand() << 15) ^ (unsigned long)rand();
+    return (int)(r % (unsigned long)n);
+}
+
+void playMatchingGame(char** groups, const uint32_t* concepts, int count) {
     printf("\n--- Match the Group to its Correct Concept ---\n");
     printf("================================================\n");
     printf("| %-2s | %-20s || %-2s | %-20s |\n", "#", "Group", "#", "Concept");
     printf("------------------------------------------------\n");
     for(int i=0; i<count; i++) {
-        printf("| %-2d | %-20s || %-2d | %-20s |\n", i+1, groups[i], i+1, concepts[i]);
+        printf("| %-2d | %-20s || %-2d | %-20s |\n", i+1, groups[i], i+1, internedName(concepts[i]));
     }
     printf("================================================\n");
 
@@ -233,7 +719,7 @@ void playMatchingGame(char** groups, char** concepts, ConceptData* original_data
     int user_matches[count];
     for(int i=0; i<count; i++) {
         printf("Match for Group #%d (%s): ", i+1, groups[i]);
-        scanf("%d", &user_matches[i]);
+        if (scanf("%d", &user_matches[i]) != 1) user_matches[i] = 0;
     }
     while(getchar() != '\n');
     
@@ -243,20 +729,17 @@ void playMatchingGame(char** groups, char** concepts, ConceptData* original_data
 
     for(int i=0; i<count; i++) {
         const char* user_group = groups[i];
-        const char* user_chosen_concept = concepts[user_matches[i]-1];
+        int choice = user_matches[i];
+        uint32_t user_chosen_concept = choice >= 1 && choice <= count ? concepts[choice-1] : NO_CONCEPT;
+        uint32_t row = conceptForGroup(user_group, strlen(user_group));
+        uint32_t correct_concept = row != NO_CONCEPT ? g_concept_db[row].concept_name : NO_CONCEPT;
         
-        char correct_concept[100] = "";
-        for(int j=0; j<count; j++){
-            if(strcmp(original_data[j].group_name, user_group) == 0) {
-                strcpy(correct_concept, original_data[j].concept_name);
-                break;
-            }
-        }
-        
-        if(strcmp(user_chosen_concept, correct_concept) == 0) {
+        if(user_chosen_concept == correct_concept) {
             correct_count++;
         } else {
-            sprintf(incorrect_matches[incorrect_count++], "Group '%s' -> Correct Concept was '%s'", user_group, correct_concept);
+            snprintf(incorrect_matches[incorrect_count++], sizeof(incorrect_matches[0]),
+                     "Group '%s' -> Correct Concept was '%s'", user_group,
+                     correct_concept != NO_CONCEPT ? internedName(correct_concept) : "");
         }
     }
     
@@ -270,6 +753,221 @@ void playMatchingGame(char** groups, char** concepts, ConceptData* original_data
     }
 }
 
+// --- Headless Batch Scoring ---
+/**
+ * @brief Splits [begin, end) at `sep` into at most `max` fields.
+ * @return The number of fields, or -1 if there are more than `max` or one is empty.
+ */
+static int splitFields(const char* begin, const char* end, char sep, const char** starts, size_t* lens, int max) {
+    int count = 0;
+    while (1) {
+        const char* next = (const char*)memchr(begin, sep, (size_t)(end - begin));
+        const char* field_end = next ? next : end;
+        if (count == max || field_end == begin) return -1;
+        starts[count] = begin;
+        lens[count++] = (size_t)(field_end - begin);
+        if (!next) return count;
+        begin = next + 1;
+    }
+}
+
+/**
+ * @brief Scores one session line into the task's tallies.
+ * @return 1 if the line was a session, 0 if it was malformed.
+ */
+static int scoreSession(ScoringTask* task, const char* line, const char* end) {
+    const char* sections[3];
+    size_t section_lens[3];
+    if (splitFields(line, end, ';', sections, section_lens, 3) != 3) return 0;
+
+    const char* groups[MAX_SESSION_ITEMS];
+    const char* concepts[MAX_SESSION_ITEMS];
+    size_t group_lens[MAX_SESSION_ITEMS], concept_lens[MAX_SESSION_ITEMS];
+    int count = splitFields(sections[0], sections[0] + section_lens[0], '|', groups, group_lens, MAX_SESSION_ITEMS);
+    if (count < 0) return 0;
+    if (splitFields(sections[1], sections[1] + section_lens[1], '|', concepts, concept_lens, MAX_SESSION_ITEMS) != count) {
+        return 0;
+    }
+
+    // Parse every match before tallying so a malformed line leaves no partial counts
+    int matches[MAX_SESSION_ITEMS];
+    const char* p = sections[2];
+    const char* matches_end = sections[2] + section_lens[2];
+    for (int i = 0; i < count; i++) {
+        while (p < matches_end && *p == ' ') p++;
+        if (p == matches_end || !isdigit((unsigned char)*p)) return 0;
+        // Read the whole run, clamping so a long number stays out of range instead of overflowing
+        int value = 0;
+        while (p < matches_end && isdigit((unsigned char)*p)) {
+            value = value > MAX_SESSION_ITEMS ? value : value * 10 + (*p - '0');
+            p++;
+        }
+        if (value < 1 || value > count || (p < matches_end && *p != ' ')) return 0;
+        matches[i] = value;
+    }
+    while (p < matches_end && *p == ' ') p++;
+    if (p != matches_end) return 0;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t row = conceptForGroup(groups[i], group_lens[i]);
+        if (row == NO_CONCEPT) {
+            task->unknown_items++;
+            continue;
+        }
+        int m = matches[i];
+        uint32_t chosen = lookupName(concepts[m - 1], concept_lens[m - 1]);
+        uint32_t correct_concept = g_concept_db[row].concept_name;
+        int correct = chosen == correct_concept;
+        task->by_group[row].attempts++;
+        task->by_group[row].correct += (uint32_t)correct;
+        task->by_concept[correct_concept].attempts++;
+        task->by_concept[correct_concept].correct += (uint32_t)correct;
+    }
+    return 1;
+}
+
+static void* scoringWorker(void* arg) {
+    ScoringTask* task = (ScoringTask*)arg;
+    const char* line = task->begin;
+    while (line < task->end) {
+        const char* nl = (const char*)memchr(line, '\n', (size_t)(task->end - line));
+        const char* line_end = nl ? nl : task->end;
+        const char* next = nl ? nl + 1 : task->end;
+        if (line_end > line && line_end[-1] == '\r') line_end--;
+        if (line_end > line && *line != '#') {
+            if (scoreSession(task, line, line_end)) task->sessions++;
+            else task->malformed++;
+        }
+        line = next;
+    }
+    return NULL;
+}
+
+static int scoringThreadCount(size_t bytes) {
+#ifndef _WIN32
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    long cpus = 4;
+#endif
+    int threads = cpus > 0 ? (int)cpus : 1;
+    if (threads > MAX_SCORING_THREADS) threads = MAX_SCORING_THREADS;
+    size_t useful = bytes / MIN_BYTES_PER_THREAD;
+    if ((size_t)threads > useful) threads = useful > 0 ? (int)useful : 1;
+    return threads;
+}
+
+static void printTally(const char* name, const MatchTally* tally) {
+    printf("%-30s %9u %9u %8.1f%%\n", name, tally->attempts, tally->correct,
+           100.0 * tally->correct / tally->attempts);
+}
+
+/**
+ * @brief Scores every recorded session in `path` across worker threads and
+ *        prints accuracy per group and per concept.
+ * @return 1 on success, 0 if the file could not be read or memory ran out.
+ */
+int scoreSessionsFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) { perror("Failed to open sessions file"); return 0; }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = (char*)malloc(size > 0 ? (size_t)size : 1);
+    if (!text || (size > 0 && fread(text, 1, (size_t)size, file) != (size_t)size)) {
+        perror("Failed to read sessions file");
+        free(text);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+    size_t bytes = size > 0 ? (size_t)size : 0;
+
+    int thread_count = scoringThreadCount(bytes);
+    ScoringTask tasks[MAX_SCORING_THREADS];
+    memset(tasks, 0, sizeof(tasks));
+    int ok = 1;
+    const char* cursor = text;
+    for (int t = 0; t < thread_count; t++) {
+        // Partition boundaries are moved forward to the next line start
+        const char* end = text + bytes * (size_t)(t + 1) / (size_t)thread_count;
+        if (end < cursor) end = cursor;
+        const char* nl = end < text + bytes ? (const char*)memchr(end, '\n', (size_t)(text + bytes - end)) : NULL;
+        end = t == thread_count - 1 || !nl ? text + bytes : nl + 1;
+        tasks[t].begin = cursor;
+        tasks[t].end = end;
+        cursor = end;
+        tasks[t].by_group = (MatchTally*)calloc((size_t)g_concept_count, sizeof(MatchTally));
+        tasks[t].by_concept = (MatchTally*)calloc((size_t)g_names.count, sizeof(MatchTally));
+        if (!tasks[t].by_group || !tasks[t].by_concept) ok = 0;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (ok) {
+        pthread_t threads[MAX_SCORING_THREADS];
+        int started = 0;
+        for (int t = 1; t < thread_count; t++) {
+            // If a thread can't start, its share runs here after the first partition
+            if (pthread_create(&threads[t], NULL, scoringWorker, &tasks[t]) == 0) started |= 1 << t;
+        }
+        scoringWorker(&tasks[0]);
+        for (int t = 1; t < thread_count; t++) {
+            if (started & (1 << t)) pthread_join(threads[t], NULL);
+            else scoringWorker(&tasks[t]);
+        }
+    } else {
+        perror("Failed to allocate scoring tallies");
+    }
+    double elapsed = secondsSince(&start);
+
+    if (ok) {
+        // Fold every worker's tallies into the first worker's
+        ScoringTask* total = &tasks[0];
+        for (int t = 1; t < thread_count; t++) {
+            for (int r = 0; r < g_concept_count; r++) {
+                total->by_group[r].attempts += tasks[t].by_group[r].attempts;
+                total->by_group[r].correct += tasks[t].by_group[r].correct;
+            }
+            for (int n = 0; n < g_names.count; n++) {
+                total->by_concept[n].attempts += tasks[t].by_concept[n].attempts;
+                total->by_concept[n].correct += tasks[t].by_concept[n].correct;
+            }
+            total->sessions += tasks[t].sessions;
+            total->malformed += tasks[t].malformed;
+            total->unknown_items += tasks[t].unknown_items;
+        }
+
+        unsigned long attempts = 0, correct = 0;
+        for (int r = 0; r < g_concept_count; r++) {
+            attempts += total->by_group[r].attempts;
+            correct += total->by_group[r].correct;
+        }
+        printf("Scored %ld session(s), %lu match(es) on %d thread(s) in %.3f s.\n",
+               total->sessions, attempts, thread_count, elapsed);
+        if (total->malformed > 0) printf("Skipped %ld malformed line(s).\n", total->malformed);
+        if (total->unknown_items > 0) printf("Skipped %ld match(es) for unknown groups.\n", total->unknown_items);
+        if (attempts > 0) printf("Overall accuracy: %.1f%%\n", 100.0 * correct / attempts);
+
+        printf("\n--- Accuracy by Group ---\n");
+        printf("%-30s %9s %9s %9s\n", "Group", "Attempts", "Correct", "Accuracy");
+        for (int r = 0; r < g_concept_count; r++) {
+            if (total->by_group[r].attempts > 0) printTally(internedName(g_concept_db[r].group_name), &total->by_group[r]);
+        }
+        printf("\n--- Accuracy by Concept ---\n");
+        printf("%-30s %9s %9s %9s\n", "Concept", "Attempts", "Correct", "Accuracy");
+        for (int n = 0; n < g_names.count; n++) {
+            if (total->by_concept[n].attempts > 0) printTally(internedName((uint32_t)n), &total->by_concept[n]);
+        }
+    }
+
+    for (int t = 0; t < thread_count; t++) {
+        free(tasks[t].by_group);
+        free(tasks[t].by_concept);
+    }
+    free(text);
+    return ok;
+}
+
 /**
  * @brief The main function for the Concept Research feature.
  */
@@ -299,33 +997,41 @@ void defineConcept() {
         num_to_extract = max_extract;
     }
     
-    ConceptData selected_data[num_to_extract];
-    int indices[g_concept_count];
-    for(int i=0; i<g_concept_count; i++) indices[i] = i;
-    for(int i=g_concept_count-1; i>0; i--) { int j = rand()%(i+1); int tmp=indices[i]; indices[i]=indices[j]; indices[j]=tmp; }
-    for(int i=0; i<num_to_extract; i++) selected_data[i] = g_concept_db[indices[i]];
+    // Draw distinct entries by rejection; only a handful are needed, however large the database
+    int indices[num_to_extract];
+    for(int i=0; i<num_to_extract; i++) {
+        int pick, seen;
+        do {
+            pick = randomIndex(g_concept_count);
+            seen = 0;
+            for(int j=0; j<i; j++) if(indices[j] == pick) seen = 1;
+        } while(seen);
+        indices[i] = pick;
+    }
     
     char* groups[num_to_extract];
-    char* concepts[num_to_extract];
+    uint32_t concepts[num_to_extract];
     for(int i=0; i<num_to_extract; i++) {
-        groups[i] = selected_data[i].group_name;
-        concepts[i] = selected_data[i].concept_name;
+        groups[i] = (char*)internedName(g_concept_db[indices[i]].group_name);
+        concepts[i] = g_concept_db[indices[i]].concept_name;
     }
-    for(int i=num_to_extract-1; i>0; i--) { int j = rand()%(i+1); char* tmp=concepts[i]; concepts[i]=concepts[j]; concepts[j]=tmp; }
+    for(int i=num_to_extract-1; i>0; i--) { int j = rand()%(i+1); uint32_t tmp=concepts[i]; concepts[i]=concepts[j]; concepts[j]=tmp; }
 
     if (use_stack) {
         printf("\nUsing STACK data structure for game.\n");
         Stack* group_s = createStack();
         Stack* concept_s = createStack();
-        for(int i=0; i<num_to_extract; i++){ push(group_s, groups[i]); push(concept_s, concepts[i]); }
-        playMatchingGame(groups, concepts, selected_data, num_to_extract);
+        if (!group_s || !concept_s) { perror("Failed to create stacks"); destroyStack(group_s); destroyStack(concept_s); return; }
+        for(int i=0; i<num_to_extract; i++){ push(group_s, groups[i]); push(concept_s, internedName(concepts[i])); }
+        playMatchingGame(groups, concepts, num_to_extract);
         destroyStack(group_s); destroyStack(concept_s);
     } else {
         printf("\nUsing QUEUE data structure for game.\n");
         Queue* group_q = createQueue();
         Queue* concept_q = createQueue();
-        for(int i=0; i<num_to_extract; i++){ enqueue(group_q, groups[i]); enqueue(concept_q, concepts[i]); }
-        playMatchingGame(groups, concepts, selected_data, num_to_extract);
+        if (!group_q || !concept_q) { perror("Failed to create queues"); destroyQueue(group_q); destroyQueue(concept_q); return; }
+        for(int i=0; i<num_to_extract; i++){ enqueue(group_q, groups[i]); enqueue(concept_q, internedName(concepts[i])); }
+        playMatchingGame(groups, concepts, num_to_extract);
         destroyQueue(group_q); destroyQueue(concept_q);
     }
     
@@ -341,4 +1047,12 @@ void cleanup_stage6_data() {
         free(g_concept_db);
         g_concept_db = NULL;
     }
+    g_concept_count = g_concept_capacity = 0;
+    free(g_text_pool.data);
+    free(g_names.text_off);
+    free(g_names.concept_of);
+    free(g_names.slots);
+    memset(&g_text_pool, 0, sizeof(g_text_pool));
+    memset(&g_names, 0, sizeof(g_names));
+    destroyNodePool();
 }
@@ -4,29 +4,155 @@
  *
  * This program combines all necessary functions into a single file. The core
  * feature is a manager for a list of acting/stage theory subjects, implemented
- * as a Singly Linked List. It supports adding, removing, and re-ordering
- * list items. A fallback mechanism is included to use hardcoded data if the
- * required input file is not found, ensuring it can run in any environment.
+ * as an implicit treap (a randomized balanced tree keyed by position). It supports
+ * adding, removing, and re-ordering list items in O(log n) each. Subject details
+ * are loaded from a memory-mapped content file in a single pass using an
+ * Aho-Corasick automaton over all subject names. A fallback mechanism is included
+ * to use hardcoded data if the required input file is not found, ensuring it can
+ * run in any environment. Both lists persist across runs: every edit is appended
+ * to a small journal, which is periodically folded into a snapshot and replayed
+ * on the next start.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h> // For toupper()
+#include <stdint.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include <io.h> // For _commit()
+#endif
+
+#define CONTENT_FILENAME "perform_stage.txt"
+#define DETAILS_PLACEHOLDER "(No details loaded yet)"
+#define TEXT_ARENA_INITIAL_CAPACITY 4096
+#define RENDER_BUFFER_INITIAL_CAPACITY 4096
+#define LIST_PAGE_SIZE 20 // Subjects shown per list on one screen
+#define SNAPSHOT_FILENAME "reading_list.snapshot"
+#define SNAPSHOT_FILENAME_TMP "reading_list.snapshot.tmp"
+#define JOURNAL_FILENAME "reading_list.journal"
+#define JOURNAL_FILENAME_TMP "reading_list.journal.tmp"
+#define SNAPSHOT_MAGIC "RLSN"
+#define JOURNAL_MAGIC "RLJN"
+#define STORE_FORMAT_VERSION 1
+#define JOURNAL_SYNC_BATCH 8         // Journal records per fsync (group commit)
+#define JOURNAL_COMPACT_RECORDS 256  // Journal length that triggers a new snapshot
 
 // --- Data Structures and Global Declarations ---
-// The structure for a single node in our linked list
+// The structure for a single node in our list. A node's position (its order
+// in the list) is not stored: it is the number of nodes before it in an in-order
+// walk, found from the subtree sizes on the way down from the root.
 typedef struct SubjectNode {
-    int order;
-    char subject_name[100];
-    char details[1024];
-    struct SubjectNode* next;
+    // Name and details live in g_text_arena as NUL-terminated strings
+    uint32_t name_off;
+    uint32_t name_len;
+    uint32_t details_off;
+    uint32_t details_len;
+    unsigned int priority;  // Random heap priority that keeps the tree balanced
+    int size;               // Number of nodes in this subtree
+    struct SubjectNode* left;
+    struct SubjectNode* right;
 } SubjectNode;
 
-// Global head pointer for the main list
-SubjectNode* g_subject_list_head = NULL;
-// (Bonus) Global head pointer for the completed list
-SubjectNode* g_read_list_head = NULL;
+// Aho-Corasick automaton over subject names. State 0 is the root. Goto edges live
+// in an open-addressing hash keyed by (state, byte), so memory stays proportional
+// to the total length of the names rather than 256 entries per state.
+typedef struct {
+    int state_count;
+    int* fail;              // Failure link of each state
+    int* best;              // Smallest subject index matched here or at any suffix, -1 if none
+    int* parent;
+    int* depth;
+    unsigned char* in_byte; // Byte on the edge from parent
+    unsigned int* edge_key; // (state << 8) | byte
+    int* edge_child;        // 0 marks an empty slot (the root is never a child)
+    int edge_capacity;      // Power of two
+    SubjectNode** subjects; // Subjects in list order; a pattern's index is its position - 1
+    int subject_count;
+} SubjectMatcher;
+
+// Append-only storage for every subject name and details string. Nodes refer to
+// their text by offset, so the arena can grow (and move) freely. Text replaced by
+// a later update or owned by a removed node stays in place until exit.
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} TextArena;
+
+TextArena g_text_arena = {NULL, 0, 0};
+uint32_t g_placeholder_off = UINT32_MAX; // Shared copy of DETAILS_PLACEHOLDER
+
+// --- On-disk Formats ---
+// Snapshot: SnapshotHeader, then for every subject (to-read list first, then the
+// completed list) a SnapshotEntry followed by "name\0details\0". It is only ever
+// replaced whole, via a temporary file and rename().
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t generation;    // Bumped by every compaction
+    uint32_t list_count[2]; // Indexed by LIST_TO_READ / LIST_COMPLETED
+} SnapshotHeader;
+
+typedef struct {
+    uint32_t name_len;
+    uint32_t details_len;
+} SnapshotEntry;
+
+// Journal: JournalHeader, then JournalRecords appended one per edit. Insert records
+// carry "name\0details\0" after the fixed part. A journal only applies on top of
+// the snapshot with the same generation; anything else is left over from an
+// interrupted compaction and is ignored.
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t generation;
+} JournalHeader;
+
+typedef struct {
+    uint8_t op;
+    uint8_t list;
+    uint16_t reserved;
+    int32_t position;       // Position exactly as passed to insertNodeAt()/removeNodeAt()
+    uint32_t name_len;
+    uint32_t details_len;
+    uint32_t checksum;      // FNV-1a over this record (with checksum = 0) and its payload
+} JournalRecord;
+
+enum { LIST_TO_READ = 0, LIST_COMPLETED = 1 };
+enum { JOURNAL_INSERT = 1, JOURNAL_REMOVE = 2, JOURNAL_COMPLETE = 3 };
+
+// Text for one list, built up and then written to stdout in a single call
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+    int failed;             // Set when growing the buffer failed; output is incomplete
+} RenderBuffer;
+
+// A whole file, either memory-mapped or (on Windows) read into a heap buffer
+typedef struct {
+    const char* data;
+    size_t size;
+} FileImage;
+
+// Global root pointer for the main list
+SubjectNode* g_subject_list_root = NULL;
+// (Bonus) Global root pointer for the completed list
+SubjectNode* g_read_list_root = NULL;
+
+int g_lists_loaded = 0;         // Set once the lists have been restored or seeded
+FILE* g_journal = NULL;         // Open for append while the store is healthy
+uint32_t g_store_generation = 0;
+int g_journal_records = 0;      // Records appended since the last snapshot
+int g_journal_unsynced = 0;     // Records written but not yet fsync'ed
+
+RenderBuffer g_render_buffer = {NULL, 0, 0, 0}; // Reused by every PrintSubjectListPage() call
 
 
 // --- Forward Declarations for All Functions ---
@@ -36,8 +162,8 @@ void show_main_menu();
 void show_training_menu();
 void show_acting_menu();
 void doReadingList();
-void PrintSubjectList(const SubjectNode* head, const char* list_name);
-void UpdateSubjectInfo(const char* line_from_file);
+void PrintSubjectListPage(const SubjectNode* root, const char* list_name, int offset, int limit);
+void UpdateSubjectInfo(const SubjectMatcher* matcher, const char* line, size_t len);
 
 
 // --- Main Entry Point ---
@@ -126,105 +252,755 @@ void show_acting_menu() {
 
 // --- Feature-Specific Functions ---
 
-// --- Linked List Operations ---
-SubjectNode* createNode(int order, const char* title, const char* author) {
+// --- Implicit Treap Operations ---
+static unsigned int g_priority_state = 2463534242u;
+
+static unsigned int nextPriority() {
+    // xorshift32: cheap, and better spread than rand() on platforms with RAND_MAX 32767
+    g_priority_state ^= g_priority_state << 13;
+    g_priority_state ^= g_priority_state >> 17;
+    g_priority_state ^= g_priority_state << 5;
+    return g_priority_state;
+}
+
+static int nodeSize(const SubjectNode* node) {
+    return node ? node->size : 0;
+}
+
+static void updateSize(SubjectNode* node) {
+    node->size = 1 + nodeSize(node->left) + nodeSize(node->right);
+}
+
+// --- Text Arena ---
+/**
+ * @brief Copies `len` bytes plus a terminator into the arena.
+ * @return 1 and the string's offset in *off, or 0 on allocation failure.
+ */
+int arenaAddText(const char* text, size_t len, uint32_t* off) {
+    if (g_text_arena.size + len + 1 > UINT32_MAX) return 0;
+    if (g_text_arena.size + len + 1 > g_text_arena.capacity) {
+        size_t new_capacity = g_text_arena.capacity ? g_text_arena.capacity : TEXT_ARENA_INITIAL_CAPACITY;
+        while (new_capacity < g_text_arena.size + len + 1) new_capacity *= 2;
+        char* new_data = (char*)realloc(g_text_arena.data, new_capacity);
+        if (!new_data) return 0;
+        g_text_arena.data = new_data;
+        g_text_arena.capacity = new_capacity;
+    }
+    *off = (uint32_t)g_text_arena.size;
+    memcpy(g_text_arena.data + g_text_arena.size, text, len);
+    g_text_arena.data[g_text_arena.size + len] = '\0';
+    g_text_arena.size += len + 1;
+    return 1;
+}
+
+const char* subjectName(const SubjectNode* node) {
+    return g_text_arena.data + node->name_off;
+}
+
+const char* subjectDetails(const SubjectNode* node) {
+    return g_text_arena.data + node->details_off;
+}
+
+/**
+ * @brief Points a node's details at a new copy of `text`.
+ * @return 1 on success, 0 on allocation failure (the old details are kept).
+ */
+int setSubjectDetails(SubjectNode* node, const char* text, size_t len) {
+    uint32_t off;
+    if (len == sizeof(DETAILS_PLACEHOLDER) - 1 && memcmp(text, DETAILS_PLACEHOLDER, len) == 0) {
+        // Every fresh subject starts with the placeholder, so it is stored once
+        if (g_placeholder_off == UINT32_MAX && !arenaAddText(text, len, &g_placeholder_off)) return 0;
+        off = g_placeholder_off;
+    } else if (!arenaAddText(text, len, &off)) {
+        return 0;
+    }
+    node->details_off = off;
+    node->details_len = (uint32_t)len;
+    return 1;
+}
+
+SubjectNode* createNode(const char* title, const char* author) {
     SubjectNode* newNode = (SubjectNode*)malloc(sizeof(SubjectNode));
-    if (!newNode) {
+    size_t name_len = strlen(title);
+    if (!newNode || !arenaAddText(title, name_len, &newNode->name_off)
+        || !setSubjectDetails(newNode, author, strlen(author))) {
         perror("Failed to allocate memory for new node");
+        free(newNode);
         return NULL;
     }
-    newNode->order = order;
-    strcpy(newNode->subject_name, title);
-    strcpy(newNode->details, author);
-    newNode->next = NULL;
+    newNode->name_len = (uint32_t)name_len;
+    newNode->priority = nextPriority();
+    newNode->size = 1;
+    newNode->left = NULL;
+    newNode->right = NULL;
     return newNode;
 }
 
-void renumberList(SubjectNode* head) {
-    int current_order = 1;
-    SubjectNode* current = head;
-    while (current != NULL) {
-        current->order = current_order++;
-        current = current->next;
+/**
+ * @brief Splits `root` into its first `count` nodes (*left) and the rest (*right).
+ */
+static void splitTreap(SubjectNode* root, int count, SubjectNode** left, SubjectNode** right) {
+    if (root == NULL) {
+        *left = *right = NULL;
+        return;
+    }
+    if (nodeSize(root->left) < count) {
+        splitTreap(root->right, count - nodeSize(root->left) - 1, &root->right, right);
+        *left = root;
+    } else {
+        splitTreap(root->left, count, left, &root->left);
+        *right = root;
+    }
+    updateSize(root);
+}
+
+/**
+ * @brief Concatenates two treaps, every node of `left` coming before every node of `right`.
+ */
+static SubjectNode* mergeTreaps(SubjectNode* left, SubjectNode* right) {
+    if (left == NULL) return right;
+    if (right == NULL) return left;
+    if (left->priority > right->priority) {
+        left->right = mergeTreaps(left->right, right);
+        updateSize(left);
+        return left;
     }
+    right->left = mergeTreaps(left, right->left);
+    updateSize(right);
+    return right;
 }
 
-void insertNodeAt(SubjectNode** p_head, SubjectNode* node_to_insert, int position) {
-    if (position <= 1 || *p_head == NULL) {
-        node_to_insert->next = *p_head;
-        *p_head = node_to_insert;
-    } else {
-        SubjectNode* current = *p_head;
-        int current_pos = 1;
-        while (current->next != NULL && current_pos < position - 1) {
-            current = current->next;
-            current_pos++;
+/**
+ * @brief Returns the number of subjects in a list.
+ */
+int listLength(const SubjectNode* root) {
+    return nodeSize(root);
+}
+
+/**
+ * @brief Returns the node at 1-based `position`, or NULL if out of range.
+ */
+SubjectNode* nodeAt(SubjectNode* root, int position) {
+    int index = position - 1;
+    while (root != NULL) {
+        int left_size = nodeSize(root->left);
+        if (index < left_size) {
+            root = root->left;
+        } else if (index == left_size) {
+            return root;
+        } else {
+            index -= left_size + 1;
+            root = root->right;
         }
-        node_to_insert->next = current->next;
-        current->next = node_to_insert;
     }
-    renumberList(*p_head);
+    return NULL;
 }
 
-SubjectNode* removeNodeAt(SubjectNode** p_head, int position) {
-    if (*p_head == NULL) return NULL;
-    SubjectNode* node_to_remove = NULL;
+/**
+ * @brief Inserts a node so it becomes the `position`-th item (1-based). Positions
+ *        before the start insert at the front; positions past the end append.
+ */
+void insertNodeAt(SubjectNode** p_root, SubjectNode* node_to_insert, int position) {
+    int count = position - 1;
+    if (count < 0) count = 0;
+    if (count > nodeSize(*p_root)) count = nodeSize(*p_root);
+    SubjectNode *left, *right;
+    splitTreap(*p_root, count, &left, &right);
+    *p_root = mergeTreaps(mergeTreaps(left, node_to_insert), right);
+}
 
-    if (position <= 1) {
-        node_to_remove = *p_head;
-        *p_head = (*p_head)->next;
-    } else {
-        SubjectNode* current = *p_head;
-        int current_pos = 1;
-        while (current->next != NULL && current_pos < position - 1) {
-            current = current->next;
-            current_pos++;
+/**
+ * @brief Detaches and returns the `position`-th node (1-based). Positions before
+ *        the start remove the first item; positions past the end return NULL.
+ */
+SubjectNode* removeNodeAt(SubjectNode** p_root, int position) {
+    if (*p_root == NULL) return NULL;
+    if (position < 1) position = 1;
+    if (position > nodeSize(*p_root)) return NULL;
+
+    SubjectNode *left, *middle, *right;
+    splitTreap(*p_root, position - 1, &left, &right);
+    splitTreap(right, 1, &middle, &right);
+    *p_root = mergeTreaps(left, right);
+    middle->left = middle->right = NULL;
+    middle->size = 1;
+    return middle;
+}
+
+static void freeTreap(SubjectNode* root) {
+    if (root == NULL) return;
+    freeTreap(root->left);
+    freeTreap(root->right);
+    free(root);
+}
+
+// --- Multi-Pattern Matching ---
+static unsigned int edgeHash(unsigned int key, int capacity) {
+    return (key * 2654435761u) & (unsigned int)(capacity - 1);
+}
+
+static int matcherGoto(const SubjectMatcher* m, int state, unsigned char c) {
+    unsigned int key = (unsigned int)state << 8 | c;
+    for (unsigned int i = edgeHash(key, m->edge_capacity); m->edge_child[i] != 0; i = (i + 1) & (m->edge_capacity - 1)) {
+        if (m->edge_key[i] == key) return m->edge_child[i];
+    }
+    return -1;
+}
+
+static void matcherAddEdge(SubjectMatcher* m, int state, unsigned char c, int child) {
+    unsigned int key = (unsigned int)state << 8 | c;
+    unsigned int i = edgeHash(key, m->edge_capacity);
+    while (m->edge_child[i] != 0) i = (i + 1) & (m->edge_capacity - 1);
+    m->edge_key[i] = key;
+    m->edge_child[i] = child;
+}
+
+static void collectSubjects(SubjectNode* node, SubjectNode** out, int* count) {
+    if (node == NULL) return;
+    collectSubjects(node->left, out, count);
+    out[(*count)++] = node;
+    collectSubjects(node->right, out, count);
+}
+
+void freeSubjectMatcher(SubjectMatcher* m) {
+    free(m->fail);
+    free(m->best);
+    free(m->parent);
+    free(m->depth);
+    free(m->in_byte);
+    free(m->edge_key);
+    free(m->edge_child);
+    free(m->subjects);
+    memset(m, 0, sizeof(*m));
+}
+
+/**
+ * @brief Builds the automaton over every subject name in `root`.
+ * @return 1 on success, 0 on allocation failure.
+ */
+int buildSubjectMatcher(SubjectMatcher* m, SubjectNode* root) {
+    memset(m, 0, sizeof(*m));
+    int n = listLength(root);
+    int max_states = 1;
+    m->subjects = (SubjectNode**)malloc((n > 0 ? n : 1) * sizeof(SubjectNode*));
+    if (!m->subjects) return 0;
+    collectSubjects(root, m->subjects, &m->subject_count);
+    for (int i = 0; i < n; i++) max_states += (int)m->subjects[i]->name_len;
+
+    m->edge_capacity = 16;
+    while (m->edge_capacity < max_states * 2) m->edge_capacity *= 2; // Load factor <= 1/2
+    m->fail = (int*)malloc(max_states * sizeof(int));
+    m->best = (int*)malloc(max_states * sizeof(int));
+    m->parent = (int*)malloc(max_states * sizeof(int));
+    m->depth = (int*)malloc(max_states * sizeof(int));
+    m->in_byte = (unsigned char*)malloc(max_states);
+    m->edge_key = (unsigned int*)malloc(m->edge_capacity * sizeof(unsigned int));
+    m->edge_child = (int*)calloc(m->edge_capacity, sizeof(int));
+    int* by_depth = (int*)malloc(max_states * sizeof(int));
+    int* depth_start = (int*)calloc(max_states + 1, sizeof(int));
+    if (!m->fail || !m->best || !m->parent || !m->depth || !m->in_byte || !m->edge_key || !m->edge_child
+        || !by_depth || !depth_start) {
+        free(by_depth);
+        free(depth_start);
+        freeSubjectMatcher(m);
+        return 0;
+    }
+
+    // Trie of all names
+    m->state_count = 1;
+    m->best[0] = -1;
+    m->parent[0] = 0;
+    m->depth[0] = 0;
+    for (int i = 0; i < n; i++) {
+        int state = 0;
+        for (const unsigned char* p = (const unsigned char*)subjectName(m->subjects[i]); *p; p++) {
+            int next = matcherGoto(m, state, *p);
+            if (next < 0) {
+                next = m->state_count++;
+                m->best[next] = -1;
+                m->parent[next] = state;
+                m->in_byte[next] = *p;
+                m->depth[next] = m->depth[state] + 1;
+                matcherAddEdge(m, state, *p, next);
+            }
+            state = next;
         }
-        if (current->next != NULL) {
-            node_to_remove = current->next;
-            current->next = node_to_remove->next;
+        // An empty name matches every line, as strstr(line, "") did
+        if (m->best[state] < 0) m->best[state] = i;
+    }
+
+    // Visit states in order of depth (counting sort), so a state's parent and
+    // every shorter suffix already have their failure links.
+    for (int s = 0; s < m->state_count; s++) depth_start[m->depth[s] + 1]++;
+    for (int d = 0; d < max_states; d++) depth_start[d + 1] += depth_start[d];
+    for (int s = 0; s < m->state_count; s++) by_depth[depth_start[m->depth[s]]++] = s;
+
+    m->fail[0] = 0;
+    for (int k = 1; k < m->state_count; k++) {
+        int s = by_depth[k];
+        int next = -1;
+        if (m->parent[s] != 0) {
+            int f = m->fail[m->parent[s]];
+            while ((next = matcherGoto(m, f, m->in_byte[s])) < 0 && f != 0) f = m->fail[f];
         }
+        m->fail[s] = next > 0 ? next : 0;
+        int inherited = m->best[m->fail[s]];
+        if (inherited >= 0 && (m->best[s] < 0 || inherited < m->best[s])) m->best[s] = inherited;
     }
-    
-    renumberList(*p_head);
-    return node_to_remove;
+    free(by_depth);
+    free(depth_start);
+    return 1;
 }
 
-// --- File I/O and Main Feature Logic ---
-void UpdateSubjectInfo(const char* line_from_file) {
-    for (SubjectNode* current = g_subject_list_head; current != NULL; current = current->next) {
-        if (strstr(line_from_file, current->subject_name) != NULL) {
-            strcpy(current->details, line_from_file);
-            return;
+/**
+ * @brief Copies the line into the details of the first subject (in list order)
+ *        whose name occurs in it.
+ */
+void UpdateSubjectInfo(const SubjectMatcher* m, const char* line, size_t len) {
+    int best = m->best[0];
+    int state = 0;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)line[i];
+        int next;
+        while ((next = matcherGoto(m, state, c)) < 0 && state != 0) state = m->fail[state];
+        state = next > 0 ? next : 0;
+        if (m->best[state] >= 0 && (best < 0 || m->best[state] < best)) best = m->best[state];
+    }
+    if (best < 0) return;
+    if (!setSubjectDetails(m->subjects[best], line, len)) perror("Failed to store subject details");
+}
+
+/**
+ * @brief Splits `text` into lines and dispatches each one through the matcher.
+ *        A line ends at '\n'; anything from its first '\r' on is dropped.
+ */
+static void scanContent(const SubjectMatcher* m, const char* text, size_t size) {
+    const char* end = text + size;
+    while (text < end) {
+        const char* nl = (const char*)memchr(text, '\n', (size_t)(end - text));
+        const char* line_end = nl ? nl : end;
+        const char* cr = (const char*)memchr(text, '\r', (size_t)(line_end - text));
+        UpdateSubjectInfo(m, text, (size_t)((cr ? cr : line_end) - text));
+        text = nl ? nl + 1 : end;
+    }
+}
+
+/**
+ * @brief Maps (or reads) a whole file. An empty file gives a NULL image.
+ * @return 1 if the file existed, 0 if it could not be opened.
+ */
+static int openFileImage(const char* path, FileImage* image) {
+    image->data = NULL;
+    image->size = 0;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            image->data = (const char*)map;
+            image->size = (size_t)st.st_size;
+        } else {
+            fprintf(stderr, "Failed to map '%s': ", path);
+            perror(NULL);
         }
     }
+    close(fd);
+    return 1;
+#else
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = size > 0 ? (char*)malloc((size_t)size) : NULL;
+    if (data && fread(data, 1, (size_t)size, file) == (size_t)size) {
+        image->data = data;
+        image->size = (size_t)size;
+    } else {
+        free(data);
+    }
+    fclose(file);
+    return 1;
+#endif
 }
 
+static void closeFileImage(FileImage* image) {
+#ifndef _WIN32
+    if (image->data) munmap((void*)image->data, image->size);
+#else
+    free((void*)image->data);
+#endif
+    image->data = NULL;
+    image->size = 0;
+}
+
+/**
+ * @brief Maps (or reads) the whole content file and scans it.
+ * @return 1 if the file existed, 0 if it could not be opened.
+ */
+static int scanContentFile(const SubjectMatcher* m) {
+    FileImage image;
+    if (!openFileImage(CONTENT_FILENAME, &image)) return 0;
+    if (image.data) scanContent(m, image.data, image.size);
+    closeFileImage(&image);
+    return 1;
+}
+
+// --- File I/O and Main Feature Logic ---
 void LoadContentFile() {
-    FILE* file = fopen("perform_stage.txt", "r");
-    if (!file) {
-        printf("Notice: 'perform_stage.txt' not found. Loading hardcoded details.\n");
+    SubjectMatcher matcher;
+    if (!buildSubjectMatcher(&matcher, g_subject_list_root)) {
+        perror("Failed to build the subject matcher");
+        return;
+    }
+    if (!scanContentFile(&matcher)) {
+        printf("Notice: '" CONTENT_FILENAME "' not found. Loading hardcoded details.\n");
         // Fallback data for online compilers
-        UpdateSubjectInfo("Acting Theory involves understanding character motivation, emotional range, and physical expression to create a believable performance.");
-        UpdateSubjectInfo("Stage Theory focuses on the use of space and design. It is crucial for creating atmosphere.");
-        UpdateSubjectInfo("Script Analysis is the deep reading of a text to understand subtext, themes, and character arcs.");
-        UpdateSubjectInfo("Dialogue Interpretation and Emotional Expression focuses on how lines are delivered to convey emotion.");
-        UpdateSubjectInfo("Character Development is the process of creating a three-dimensional character with a backstory and goals.");
-        UpdateSubjectInfo("Storytelling Theory covers the structure of narrative, including plot points, pacing, and tension.");
-        UpdateSubjectInfo("Stage Movement and Poses concerns how an actor uses their body to command a space non-verbally.");
+        static const char* fallback_lines[] = {
+            "Acting Theory involves understanding character motivation, emotional range, and physical expression to create a believable performance.",
+            "Stage Theory focuses on the use of space and design. It is crucial for creating atmosphere.",
+            "Script Analysis is the deep reading of a text to understand subtext, themes, and character arcs.",
+            "Dialogue Interpretation and Emotional Expression focuses on how lines are delivered to convey emotion.",
+            "Character Development is the process of creating a three-dimensional character with a backstory and goals.",
+            "Storytelling Theory covers the structure of narrative, including plot points, pacing, and tension.",
+            "Stage Movement and Poses concerns how an actor uses their body to command a space non-verbally."
+        };
+        for (size_t i = 0; i < sizeof(fallback_lines) / sizeof(fallback_lines[0]); i++) {
+            UpdateSubjectInfo(&matcher, fallback_lines[i], strlen(fallback_lines[i]));
+        }
+    }
+    freeSubjectMatcher(&matcher);
+}
+
+// --- Persistence: Snapshot and Journal ---
+static SubjectNode** listRoot(int list) {
+    return list == LIST_COMPLETED ? &g_read_list_root : &g_subject_list_root;
+}
+
+static uint32_t fnv1a(uint32_t hash, const void* data, size_t len) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t journalChecksum(const JournalRecord* rec, const char* name, const char* details) {
+    JournalRecord copy = *rec;
+    copy.checksum = 0;
+    uint32_t hash = fnv1a(2166136261u, &copy, sizeof(copy));
+    if (rec->op == JOURNAL_INSERT) {
+        hash = fnv1a(hash, name, (size_t)rec->name_len + 1);
+        hash = fnv1a(hash, details, (size_t)rec->details_len + 1);
+    }
+    return hash;
+}
+
+/**
+ * @brief Flushes a stream and forces its contents to stable storage.
+ */
+static int syncFile(FILE* file) {
+    if (fflush(file) != 0) return 0;
+#ifndef _WIN32
+    return fsync(fileno(file)) == 0;
+#else
+    return _commit(_fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief Replaces `path` with `tmp_path` and makes the rename itself durable.
+ */
+static int replaceFile(const char* tmp_path, const char* path) {
+#ifdef _WIN32
+    remove(path); // rename() does not replace an existing file on Windows
+#endif
+    if (rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        return 0;
+    }
+#ifndef _WIN32
+    int dir = open(".", O_RDONLY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+#endif
+    return 1;
+}
+
+/**
+ * @brief Moves the `position`-th to-read subject to the end of the completed list.
+ * @return The moved node, or NULL if the position is out of range.
+ */
+SubjectNode* completeSubjectAt(int position) {
+    SubjectNode* node = removeNodeAt(&g_subject_list_root, position);
+    if (node) g_read_list_root = mergeTreaps(g_read_list_root, node);
+    return node;
+}
+
+static int writeSnapshotNodes(FILE* file, const SubjectNode* node) {
+    if (node == NULL) return 1;
+    if (!writeSnapshotNodes(file, node->left)) return 0;
+    SnapshotEntry entry = {node->name_len, node->details_len};
+    if (fwrite(&entry, sizeof(entry), 1, file) != 1
+        || fwrite(subjectName(node), 1, node->name_len + 1, file) != node->name_len + 1
+        || fwrite(subjectDetails(node), 1, node->details_len + 1, file) != node->details_len + 1) {
+        return 0;
+    }
+    return writeSnapshotNodes(file, node->right);
+}
+
+static int writeSnapshot(uint32_t generation) {
+    FILE* file = fopen(SNAPSHOT_FILENAME_TMP, "wb");
+    if (!file) return 0;
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = STORE_FORMAT_VERSION;
+    header.generation = generation;
+    header.list_count[LIST_TO_READ] = (uint32_t)listLength(g_subject_list_root);
+    header.list_count[LIST_COMPLETED] = (uint32_t)listLength(g_read_list_root);
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && writeSnapshotNodes(file, g_subject_list_root)
+        && writeSnapshotNodes(file, g_read_list_root)
+        && syncFile(file);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        remove(SNAPSHOT_FILENAME_TMP);
+        return 0;
+    }
+    return replaceFile(SNAPSHOT_FILENAME_TMP, SNAPSHOT_FILENAME);
+}
+
+/**
+ * @brief Replaces the journal with an empty one for `generation` and opens it for append.
+ */
+static int startJournal(uint32_t generation) {
+    FILE* file = fopen(JOURNAL_FILENAME_TMP, "wb");
+    if (!file) return 0;
+    JournalHeader header;
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = STORE_FORMAT_VERSION;
+    header.generation = generation;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 && syncFile(file);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        remove(JOURNAL_FILENAME_TMP);
+        return 0;
+    }
+    if (!replaceFile(JOURNAL_FILENAME_TMP, JOURNAL_FILENAME)) return 0;
+    g_journal = fopen(JOURNAL_FILENAME, "ab");
+    return g_journal != NULL;
+}
+
+/**
+ * @brief Writes both lists to a new snapshot and starts an empty journal after it.
+ *        The snapshot lands first; a crash before the journal is replaced leaves
+ *        a journal from the previous generation, which loading then ignores.
+ */
+void compactReadingList() {
+    if (g_journal) {
+        fclose(g_journal);
+        g_journal = NULL;
+    }
+    g_journal_records = 0;
+    g_journal_unsynced = 0;
+    if (!writeSnapshot(g_store_generation + 1)) {
+        perror("Failed to write reading list snapshot");
+        // The old snapshot and journal are untouched, so keep appending to them
+        g_journal = fopen(JOURNAL_FILENAME, "ab");
         return;
     }
-    
-    char line[1024];
-    while (fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\r\n")] = 0;
-        UpdateSubjectInfo(line);
+    g_store_generation++;
+    if (!startJournal(g_store_generation)) {
+        // Edits fall back to full snapshots until a journal can be started
+        perror("Failed to start reading list journal");
+    }
+}
+
+/**
+ * @brief Forces journal records written so far to stable storage.
+ */
+void journalSync() {
+    if (g_journal && g_journal_unsynced > 0) {
+        if (!syncFile(g_journal)) perror("Failed to sync reading list journal");
+        g_journal_unsynced = 0;
     }
-    fclose(file);
+}
+
+/**
+ * @brief Appends one edit to the journal. The record reaches the OS immediately;
+ *        fsync is batched over JOURNAL_SYNC_BATCH records, and the journal is
+ *        folded into a snapshot every JOURNAL_COMPACT_RECORDS records.
+ * @param node The inserted node for JOURNAL_INSERT, otherwise NULL.
+ */
+void journalRecord(int op, int list, int position, const SubjectNode* node) {
+    if (g_journal == NULL) {
+        compactReadingList();
+        return;
+    }
+    JournalRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.op = (uint8_t)op;
+    rec.list = (uint8_t)list;
+    rec.position = position;
+    rec.name_len = node ? node->name_len : 0;
+    rec.details_len = node ? node->details_len : 0;
+    rec.checksum = node ? journalChecksum(&rec, subjectName(node), subjectDetails(node))
+                        : journalChecksum(&rec, NULL, NULL);
+
+    int ok = fwrite(&rec, sizeof(rec), 1, g_journal) == 1;
+    if (ok && node) {
+        ok = fwrite(subjectName(node), 1, rec.name_len + 1, g_journal) == rec.name_len + 1
+            && fwrite(subjectDetails(node), 1, rec.details_len + 1, g_journal) == rec.details_len + 1;
+    }
+    if (!ok || fflush(g_journal) != 0) {
+        perror("Failed to append to reading list journal");
+        compactReadingList(); // Drops the damaged tail by capturing the current lists
+        return;
+    }
+    if (++g_journal_records >= JOURNAL_COMPACT_RECORDS) {
+        compactReadingList();
+    } else if (++g_journal_unsynced >= JOURNAL_SYNC_BATCH) {
+        journalSync();
+    }
+}
+
+/**
+ * @brief Rebuilds both lists from a snapshot image.
+ * @return 1 on success, 0 if the image is malformed.
+ */
+static int restoreSnapshot(const char* data, size_t size) {
+    SnapshotHeader header;
+    if (size < sizeof(header)) return 0;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0
+        || header.version != STORE_FORMAT_VERSION) {
+        return 0;
+    }
+    size_t off = sizeof(header);
+    for (int list = LIST_TO_READ; list <= LIST_COMPLETED; list++) {
+        SubjectNode** root = listRoot(list);
+        for (uint32_t i = 0; i < header.list_count[list]; i++) {
+            SnapshotEntry entry;
+            if (size - off < sizeof(entry)) return 0;
+            memcpy(&entry, data + off, sizeof(entry));
+            off += sizeof(entry);
+            const char* name = data + off;
+            if (size - off < (size_t)entry.name_len + 1 || name[entry.name_len] != '\0') return 0;
+            off += (size_t)entry.name_len + 1;
+            const char* details = data + off;
+            if (size - off < (size_t)entry.details_len + 1 || details[entry.details_len] != '\0') return 0;
+            off += (size_t)entry.details_len + 1;
+            SubjectNode* node = createNode(name, details);
+            if (!node) return 0;
+            *root = mergeTreaps(*root, node);
+        }
+    }
+    g_store_generation = header.generation;
+    return off == size;
+}
+
+/**
+ * @brief Applies the journal's records on top of the restored snapshot, stopping
+ *        at the first torn or corrupt record.
+ * @return 1 if the whole journal applied cleanly and can be appended to,
+ *         0 if it was stale, damaged, or only partly applied.
+ */
+static int replayJournal(const char* data, size_t size) {
+    JournalHeader header;
+    if (size < sizeof(header)) return 0;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0
+        || header.version != STORE_FORMAT_VERSION
+        || header.generation != g_store_generation) {
+        return 0;
+    }
+    size_t off = sizeof(header);
+    while (off < size) {
+        JournalRecord rec;
+        if (size - off < sizeof(rec)) return 0;
+        memcpy(&rec, data + off, sizeof(rec));
+        if (rec.list > LIST_COMPLETED) return 0;
+        const char* name = NULL;
+        const char* details = NULL;
+        size_t next = off + sizeof(rec);
+        if (rec.op == JOURNAL_INSERT) {
+            name = data + next;
+            if (size - next < (size_t)rec.name_len + 1 || name[rec.name_len] != '\0') return 0;
+            next += (size_t)rec.name_len + 1;
+            details = data + next;
+            if (size - next < (size_t)rec.details_len + 1 || details[rec.details_len] != '\0') return 0;
+            next += (size_t)rec.details_len + 1;
+        }
+        if (journalChecksum(&rec, name, details) != rec.checksum) return 0;
+
+        SubjectNode** root = listRoot(rec.list);
+        SubjectNode* node;
+        switch (rec.op) {
+            case JOURNAL_INSERT:
+                node = createNode(name, details);
+                if (!node) return 0;
+                insertNodeAt(root, node, rec.position);
+                break;
+            case JOURNAL_REMOVE:
+                node = removeNodeAt(root, rec.position);
+                if (!node) return 0;
+                free(node);
+                break;
+            case JOURNAL_COMPLETE:
+                if (!completeSubjectAt(rec.position)) return 0;
+                break;
+            default:
+                return 0;
+        }
+        g_journal_records++;
+        off = next;
+    }
+    return 1;
+}
+
+/**
+ * @brief Restores both lists from the snapshot and journal, if a snapshot exists.
+ * @return 1 if the lists were restored, 0 if there is no usable stored state.
+ */
+int loadReadingList() {
+    FileImage image;
+    if (!openFileImage(SNAPSHOT_FILENAME, &image)) return 0;
+    int ok = restoreSnapshot(image.data, image.size);
+    closeFileImage(&image);
+    if (!ok) {
+        printf("Warning: '" SNAPSHOT_FILENAME "' is damaged. Starting from the default list.\n");
+        freeTreap(g_subject_list_root);
+        freeTreap(g_read_list_root);
+        g_subject_list_root = g_read_list_root = NULL;
+        g_store_generation = 0;
+        return 0;
+    }
+
+    int clean = 0;
+    if (openFileImage(JOURNAL_FILENAME, &image)) {
+        clean = replayJournal(image.data, image.size);
+        closeFileImage(&image);
+    }
+    if (clean) {
+        g_journal = fopen(JOURNAL_FILENAME, "ab");
+        if (!g_journal) perror("Failed to open reading list journal");
+    } else {
+        // Missing, stale, or torn journal: fold whatever applied into a fresh snapshot
+        compactReadingList();
+    }
+    return 1;
 }
 
 void initializeSubjectList() {
-     if (g_subject_list_head != NULL) return;
+     if (g_lists_loaded) return;
+     g_lists_loaded = 1;
+     if (loadReadingList()) return;
      printf("Initializing subject list...\n");
      const char* subjects[] = {
         "Acting Theory", "Stage Theory", "Script Analysis",
@@ -232,16 +1008,11 @@ void initializeSubjectList() {
         "Storytelling Theory", "Stage Movement and Poses"
      };
      for(int i=0; i < 7; i++){
-        SubjectNode* newNode = createNode(i+1, subjects[i], "(No details loaded yet)");
-        if(g_subject_list_head == NULL) {
-            g_subject_list_head = newNode;
-        } else {
-            SubjectNode* current = g_subject_list_head;
-            while(current->next != NULL) current = current->next;
-            current->next = newNode;
-        }
+        SubjectNode* newNode = createNode(subjects[i], DETAILS_PLACEHOLDER);
+        if (newNode) g_subject_list_root = mergeTreaps(g_subject_list_root, newNode);
      }
      LoadContentFile();
+     compactReadingList(); // First snapshot
 }
 
 /**
@@ -252,24 +1023,37 @@ void doReadingList() {
     
     char buffer[100];
     int choice;
+    int page_offset = 0; // First subject shown on the current page, shared by both lists
     while(1) {
         clear_screen();
         printf("========================================\n");
         printf("      Reading List Management\n");
         printf("========================================\n");
-        PrintSubjectList(g_subject_list_head, "To-Read List");
-        PrintSubjectList(g_read_list_head, "Completed Books (Bonus)");
+        int longest = listLength(g_subject_list_root);
+        if (listLength(g_read_list_root) > longest) longest = listLength(g_read_list_root);
+        while (page_offset > 0 && page_offset >= longest) page_offset -= LIST_PAGE_SIZE; // Lists shrank
+        if (page_offset < 0) page_offset = 0;
+        PrintSubjectListPage(g_subject_list_root, "To-Read List", page_offset, LIST_PAGE_SIZE);
+        PrintSubjectListPage(g_read_list_root, "Completed Books (Bonus)", page_offset, LIST_PAGE_SIZE);
         
         printf("\nChoose an action:\n");
         printf("  1. Add New Subject (Bonus)\n");
         printf("  2. Remove Subject (Bonus)\n");
+        printf("  3. Mark Subject as Completed (Bonus)\n");
+        if (longest > LIST_PAGE_SIZE) {
+            printf("  4. Next Page\n");
+            printf("  5. Previous Page\n");
+        }
         printf("  0. Back to previous menu\n");
         printf("Choice: ");
         
         fgets(buffer, sizeof(buffer), stdin);
         choice = atoi(buffer);
 
-        if (choice == 0) break;
+        if (choice == 0) {
+            journalSync();
+            break;
+        }
         
         int pos;
         char name[100], details[1024];
@@ -282,24 +1066,45 @@ void doReadingList() {
                 fgets(name, sizeof(name), stdin); name[strcspn(name, "\n")] = 0;
                 printf("Enter new subject details: ");
                 fgets(details, sizeof(details), stdin); details[strcspn(details, "\n")] = 0;
-                SubjectNode* new_node = createNode(0, name, details);
-                insertNodeAt(&g_subject_list_head, new_node, pos);
+                SubjectNode* new_node = createNode(name, details);
+                if (new_node) {
+                    insertNodeAt(&g_subject_list_root, new_node, pos);
+                    journalRecord(JOURNAL_INSERT, LIST_TO_READ, pos, new_node);
+                }
                 break;
             case 2:
                 printf("Enter position of the subject to remove: ");
                 fgets(buffer, sizeof(buffer), stdin); pos = atoi(buffer);
-                SubjectNode* removed_node = removeNodeAt(&g_subject_list_head, pos);
+                SubjectNode* removed_node = removeNodeAt(&g_subject_list_root, pos);
                 if (removed_node) {
-                    printf("Removed: \"%s\"\n", removed_node->subject_name);
+                    journalRecord(JOURNAL_REMOVE, LIST_TO_READ, pos, NULL);
+                    printf("Removed: \"%s\"\n", subjectName(removed_node));
                     free(removed_node);
                 } else {
                     printf("Invalid position.\n");
                 }
                 break;
+            case 3:
+                printf("Enter position of the subject to mark as completed: ");
+                fgets(buffer, sizeof(buffer), stdin); pos = atoi(buffer);
+                SubjectNode* completed_node = completeSubjectAt(pos);
+                if (completed_node) {
+                    journalRecord(JOURNAL_COMPLETE, LIST_TO_READ, pos, NULL);
+                    printf("Completed: \"%s\"\n", subjectName(completed_node));
+                } else {
+                    printf("Invalid position.\n");
+                }
+                break;
+            case 4:
+                if (page_offset + LIST_PAGE_SIZE < longest) page_offset += LIST_PAGE_SIZE;
+                continue;
+            case 5:
+                page_offset = page_offset > LIST_PAGE_SIZE ? page_offset - LIST_PAGE_SIZE : 0;
+                continue;
             default:
                 printf("Invalid choice. Please try again.\n");
         }
-        if(choice >= 1 && choice <= 2) {
+        if(choice >= 1 && choice <= 3) {
              printf("\nOperation complete. Press Enter to continue...");
              getchar();
         }
@@ -308,16 +1113,97 @@ void doReadingList() {
 
 // --- Cleanup ---
 void cleanupLists() {
-    SubjectNode *current, *next;
-    current = g_subject_list_head;
-    while(current != NULL) { next = current->next; free(current); current = next; }
-    current = g_read_list_head;
-    while(current != NULL) { next = current->next; free(current); current = next; }
+    free(g_render_buffer.data);
+    g_render_buffer.data = NULL;
+    g_render_buffer.size = g_render_buffer.capacity = 0;
+    journalSync();
+    if (g_journal) {
+        fclose(g_journal);
+        g_journal = NULL;
+    }
+    freeTreap(g_subject_list_root);
+    freeTreap(g_read_list_root);
+    g_subject_list_root = NULL;
+    g_read_list_root = NULL;
+    free(g_text_arena.data);
+    g_text_arena.data = NULL;
+    g_text_arena.size = g_text_arena.capacity = 0;
+    g_placeholder_off = UINT32_MAX;
 }
 
 // --- Print function with special formatting ---
-void PrintSubjectList(const SubjectNode* head, const char* list_name) {
-    if (head == NULL && strcmp(list_name, "To-Read List") == 0) {
+static void renderAppend(RenderBuffer* out, const char* text, size_t len) {
+    if (out->failed) return;
+    if (out->size + len > out->capacity) {
+        size_t new_capacity = out->capacity ? out->capacity : RENDER_BUFFER_INITIAL_CAPACITY;
+        while (new_capacity < out->size + len) new_capacity *= 2;
+        char* new_data = (char*)realloc(out->data, new_capacity);
+        if (!new_data) {
+            out->failed = 1;
+            return;
+        }
+        out->data = new_data;
+        out->capacity = new_capacity;
+    }
+    memcpy(out->data + out->size, text, len);
+    out->size += len;
+}
+
+static void renderString(RenderBuffer* out, const char* text) {
+    renderAppend(out, text, strlen(text));
+}
+
+/**
+ * @brief Appends details, breaking the line (with an indent) after every period
+ *        that is followed by a space. Whole segments are copied between breaks.
+ */
+static void renderDetails(RenderBuffer* out, const char* details, size_t len) {
+    static const char line_break[] = "\n            "; // Newline and indent after a period.
+    const char* end = details + len;
+    const char* segment = details;
+    const char* scan = details;
+    const char* dot;
+    while ((dot = (const char*)memchr(scan, '.', (size_t)(end - scan))) != NULL) {
+        scan = dot + 1;
+        if (scan < end && *scan == ' ') {
+            renderAppend(out, segment, (size_t)(scan - segment));
+            renderAppend(out, line_break, sizeof(line_break) - 1);
+            segment = scan;
+        }
+    }
+    renderAppend(out, segment, (size_t)(end - segment));
+}
+
+/**
+ * @brief Renders the subjects at 0-based indices [from, to) of the subtree whose
+ *        first node has index `base`. Subtrees outside the window are skipped
+ *        using their sizes, so only O(log n + window) nodes are visited.
+ */
+static void renderSubjectRange(RenderBuffer* out, const SubjectNode* node, int base, int from, int to) {
+    while (node != NULL && base < to) {
+        int index = base + nodeSize(node->left);
+        if (from < index) renderSubjectRange(out, node->left, base, from, to);
+        if (index >= to) return;
+        if (index >= from) {
+            char number[16];
+            snprintf(number, sizeof(number), "\n%d. ", index + 1);
+            renderString(out, number);
+            renderString(out, "Subject: ");
+            renderAppend(out, subjectName(node), node->name_len);
+            renderString(out, "\n   Details: ");
+            renderDetails(out, subjectDetails(node), node->details_len);
+            renderString(out, "\n");
+        }
+        base = index + 1;
+        node = node->right;
+    }
+}
+
+/**
+ * @brief Prints at most `limit` subjects of a list, starting after the first `offset`.
+ */
+void PrintSubjectListPage(const SubjectNode* root, const char* list_name, int offset, int limit) {
+    if (root == NULL && strcmp(list_name, "To-Read List") == 0) {
         // Only show this detailed message if the main list is empty.
         printf("\n--- %s ---\n", list_name);
         printf("The list is empty.\n");
@@ -325,25 +1211,30 @@ void PrintSubjectList(const SubjectNode* head, const char* list_name) {
         return;
     }
     // If the read list is empty, it's fine to just show that.
-    if(head == NULL) return;
+    if(root == NULL) return;
 
-    printf("\n--- %s ---\n", list_name);
-    
-    int order = 1;
-    const SubjectNode* current = head;
-    while(current != NULL) {
-        printf("\n%d. Subject: %s\n", order++, current->subject_name);
-        printf("   Details: ");
-        
-        int len = strlen(current->details);
-        for(int i=0; i<len; i++) {
-            printf("%c", current->details[i]);
-            if (current->details[i] == '.' && i < len - 1 && current->details[i+1] == ' ') {
-                printf("\n            "); // Newline and indent after a period.
-            }
+    int total = listLength(root);
+    if (offset < 0) offset = 0;
+    if (limit < 0 || limit > total - offset) limit = total - offset > 0 ? total - offset : 0;
+
+    RenderBuffer* out = &g_render_buffer;
+    out->size = 0;
+    out->failed = 0;
+    renderString(out, "\n--- ");
+    renderString(out, list_name);
+    renderString(out, " ---\n");
+    renderSubjectRange(out, root, 0, offset, offset + limit);
+    if (limit < total) {
+        char footer[64];
+        if (limit > 0) {
+            snprintf(footer, sizeof(footer), "\n(Showing %d-%d of %d)\n", offset + 1, offset + limit, total);
+        } else {
+            snprintf(footer, sizeof(footer), "\n(%d subject(s), none on this page)\n", total);
         }
-        printf("\n");
-        current = current->next;
+        renderString(out, footer);
     }
-    printf("----------------------------------------\n");
+    renderString(out, "----------------------------------------\n");
+
+    if (out->failed) perror("Failed to render subject list");
+    fwrite(out->data, 1, out->size, stdout);
 }